@@ -2,6 +2,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 class Seven {
 public:
@@ -45,19 +46,59 @@ public:
     // Вывод массива в поток
     std::ostream& print(std::ostream& outputStream) const;
 
+    // === ТЕОРЕТИКО-ЧИСЛОВЫЕ ОПЕРАЦИИ ===
+
+    // Наибольший общий делитель (алгоритм Лемера, для малых чисел - бинарный)
+    Seven gcd(const Seven& other) const;
+
+    // Целая часть квадратного корня (метод Ньютона)
+    Seven isqrt() const;
+
+    // === ПРЕДСТАВЛЕНИЕ ===
+
+    // Хранится ли число сериями (цифра, длина) вместо плотного массива
+    bool isRunLength() const;
+
+    // Количество байт, занимаемых разрядами числа
+    size_t storageSize() const;
+
     // === ДЕСТРУКТОР ===
     
     // Виртуальный деструктор (Правило пяти)
     virtual ~Seven() noexcept;
 
 private:
+    // Серия одинаковых цифр, начиная с младших разрядов
+    struct Run {
+        unsigned char digit;
+        size_t length;
+    };
+
+    class RunCursor;
+
+    // Сжатое представление выбирается, если плотный массив
+    // занимает хотя бы во столько раз больше памяти, чем серии
+    static const size_t compressionRatio = 2;
+
     // === ДАННЫЕ-ЧЛЕНЫ ===
     
-    size_t arraySize;           // Размер массива
-    unsigned char* dataArray;   // Указатель на динамический массив
+    size_t arraySize;           // Размер массива (количество разрядов)
+    unsigned char* dataArray;   // Указатель на динамический массив (nullptr в RLE-режиме)
+    size_t runCount;            // Количество серий
+    Run* runArray;              // Указатель на массив серий (nullptr в плотном режиме)
 
     unsigned char charToDigit(char c) const;
     char digitToChar(unsigned char digit) const;
     void validateString(const std::string& str) const;
     void removeLeadingZeros();
+
+    std::vector<unsigned char> digits() const;
+    static Seven fromDigits(const std::vector<unsigned char>& digits);
+    static void appendRun(std::vector<Run>& runs, unsigned char digit, size_t length);
+    static Seven fromRuns(const std::vector<Run>& runs, size_t size);
+    bool worthCompressing(size_t runs) const;
+    void chooseRepresentation();
+    int compare(const Seven& other) const;
+    Seven addRuns(const Seven& other) const;
+    Seven subtractRuns(const Seven& other) const;
 };
\ No newline at end of file
@@ -1,6 +1,284 @@
 #include "seven.h"
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+
+class Seven::RunCursor {
+public:
+    RunCursor(const Seven& number, bool fromTop)
+        : number(number), fromTop(fromTop), consumed(0), currentDigit(0), currentLength(0) {
+        load();
+    }
+
+    bool empty() const { return currentLength == 0; }
+    unsigned char digit() const { return currentDigit; }
+    size_t length() const { return currentLength; }
+
+    void skip(size_t count) {
+        if (empty()) return;
+        currentLength -= count;
+        if (currentLength == 0) load();
+    }
+
+private:
+    const Seven& number;
+    bool fromTop;
+    size_t consumed;
+    unsigned char currentDigit;
+    size_t currentLength;
+
+    void load() {
+        if (number.runArray != nullptr) {
+            if (consumed < number.runCount) {
+                const Run& run = number.runArray[fromTop ? number.runCount - 1 - consumed : consumed];
+                currentDigit = run.digit;
+                currentLength = run.length;
+                ++consumed;
+            }
+            return;
+        }
+
+        if (consumed >= number.arraySize) return;
+
+        currentDigit = digitAt(consumed);
+        currentLength = 1;
+        while (consumed + currentLength < number.arraySize &&
+               digitAt(consumed + currentLength) == currentDigit) {
+            ++currentLength;
+        }
+        consumed += currentLength;
+    }
+
+    unsigned char digitAt(size_t offset) const {
+        return number.dataArray[fromTop ? number.arraySize - 1 - offset : offset];
+    }
+};
+
+// Арифметика над разрядами в виде вектора (младшие разряды первыми, без ведущих нулей)
+namespace {
+
+using Digits = std::vector<unsigned char>;
+
+// Столько разрядов по основанию 7 гарантированно помещается в int64_t
+const size_t wordDigits = 22;
+
+// Столько старших разрядов берет одна итерация алгоритма Лемера
+const size_t lehmerDigits = 20;
+
+void trim(Digits& a) {
+    while (!a.empty() && a.back() == 0) a.pop_back();
+}
+
+int compareDigits(const Digits& a, const Digits& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// a -= b, требуется a >= b
+void subtractDigits(Digits& a, const Digits& b) {
+    int borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int diff = a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = diff < 0 ? 1 : 0;
+        a[i] = diff + 7 * borrow;
+        if (i >= b.size() && !borrow) break;
+    }
+    trim(a);
+}
+
+Digits addDigits(const Digits& a, const Digits& b) {
+    Digits result;
+    result.reserve(std::max(a.size(), b.size()) + 1);
+    unsigned char carry = 0;
+    for (size_t i = 0; i < a.size() || i < b.size() || carry; ++i) {
+        unsigned char sum = (i < a.size() ? a[i] : 0) + (i < b.size() ? b[i] : 0) + carry;
+        carry = sum / 7;
+        result.push_back(sum % 7);
+    }
+    return result;
+}
+
+// Промежуточные значения не превосходят 7 * factor, поэтому factor < 7^20 безопасен
+Digits multiplySmall(const Digits& a, uint64_t factor) {
+    Digits result;
+    if (factor == 0) return result;
+    result.reserve(a.size() + wordDigits);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t value = a[i] * factor + carry;
+        result.push_back(value % 7);
+        carry = value / 7;
+    }
+    while (carry) {
+        result.push_back(carry % 7);
+        carry /= 7;
+    }
+    trim(result);
+    return result;
+}
+
+Digits divideSmall(const Digits& a, unsigned divisor) {
+    Digits result(a.size());
+    unsigned remainder = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        unsigned value = remainder * 7 + a[i];
+        result[i] = value / divisor;
+        remainder = value % divisor;
+    }
+    trim(result);
+    return result;
+}
+
+// Деление в столбик: каждая цифра частного подбирается не более чем шестью вычитаниями
+void divideDigits(const Digits& a, const Digits& b, Digits& quotient, Digits& remainder) {
+    quotient.assign(a.size(), 0);
+    remainder.clear();
+    for (size_t i = a.size(); i-- > 0;) {
+        remainder.insert(remainder.begin(), a[i]);
+        trim(remainder);
+        unsigned char digit = 0;
+        while (compareDigits(remainder, b) >= 0) {
+            subtractDigits(remainder, b);
+            ++digit;
+        }
+        quotient[i] = digit;
+    }
+    trim(quotient);
+}
+
+Digits modDigits(const Digits& a, const Digits& b) {
+    Digits quotient, remainder;
+    divideDigits(a, b, quotient, remainder);
+    return remainder;
+}
+
+// Значение разрядов a, начиная с позиции shift; результат должен помещаться в слово
+uint64_t topWord(const Digits& a, size_t shift) {
+    uint64_t value = 0;
+    for (size_t i = a.size(); i-- > shift;) {
+        value = value * 7 + a[i];
+    }
+    return value;
+}
+
+Digits fromWord(uint64_t value) {
+    Digits result;
+    while (value) {
+        result.push_back(value % 7);
+        value /= 7;
+    }
+    return result;
+}
+
+uint64_t binaryGcd(uint64_t u, uint64_t v) {
+    if (u == 0) return v;
+    if (v == 0) return u;
+
+    int shift = 0;
+    while (((u | v) & 1) == 0) {
+        u >>= 1;
+        v >>= 1;
+        ++shift;
+    }
+    while ((u & 1) == 0) u >>= 1;
+
+    while (v != 0) {
+        while ((v & 1) == 0) v >>= 1;
+        if (u > v) std::swap(u, v);
+        v -= u;
+    }
+    return u << shift;
+}
+
+// Вычисляет x * a + y * b, где у x и y разные знаки, а результат неотрицателен
+Digits combine(const Digits& a, const Digits& b, int64_t x, int64_t y) {
+    if (y == 0) return multiplySmall(a, static_cast<uint64_t>(x));
+    if (x == 0) return multiplySmall(b, static_cast<uint64_t>(y));
+
+    Digits pa = multiplySmall(a, static_cast<uint64_t>(x < 0 ? -x : x));
+    Digits pb = multiplySmall(b, static_cast<uint64_t>(y < 0 ? -y : y));
+    if (x > 0) {
+        subtractDigits(pa, pb);
+        return pa;
+    }
+    subtractDigits(pb, pa);
+    return pb;
+}
+
+Digits lehmerGcd(Digits a, Digits b) {
+    if (compareDigits(a, b) < 0) a.swap(b);
+
+    while (b.size() > wordDigits) {
+        size_t shift = a.size() - lehmerDigits;
+        int64_t x = static_cast<int64_t>(topWord(a, shift));
+        int64_t y = b.size() > shift ? static_cast<int64_t>(topWord(b, shift)) : 0;
+        int64_t A = 1, B = 0, C = 0, D = 1;
+
+        while (y + C != 0 && y + D != 0) {
+            int64_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D)) break;
+
+            int64_t t = A - q * C; A = C; C = t;
+            t = B - q * D; B = D; D = t;
+            t = x - q * y; x = y; y = t;
+        }
+
+        if (B == 0) {
+            Digits r = modDigits(a, b);
+            a.swap(b);
+            b.swap(r);
+        } else {
+            Digits na = combine(a, b, A, B);
+            Digits nb = combine(a, b, C, D);
+            a.swap(na);
+            b.swap(nb);
+        }
+    }
+
+    if (b.empty()) return a;
+    if (a.size() > wordDigits) a = modDigits(a, b);
+
+    return fromWord(binaryGcd(topWord(a, 0), topWord(b, 0)));
+}
+
+// Начальное приближение не меньше точного корня, дальше итерации Ньютона убывают
+Digits newtonSqrt(const Digits& n) {
+    if (n.empty()) return n;
+
+    if (n.size() <= wordDigits) {
+        uint64_t value = topWord(n, 0);
+        uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(value)));
+        while (root * root > value) --root;
+        while ((root + 1) * (root + 1) <= value) ++root;
+        return fromWord(root);
+    }
+
+    size_t shift = n.size() - lehmerDigits;
+    double leading = static_cast<double>(topWord(n, shift));
+    if (shift % 2 == 1) {
+        leading *= 7;
+        --shift;
+    }
+
+    Digits x(shift / 2, 0);
+    Digits estimate = fromWord(static_cast<uint64_t>(std::sqrt(leading) * (1 + 1e-12)) + 1);
+    x.insert(x.end(), estimate.begin(), estimate.end());
+
+    while (true) {
+        Digits quotient, remainder;
+        divideDigits(n, x, quotient, remainder);
+        Digits y = divideSmall(addDigits(x, quotient), 2);
+        if (compareDigits(y, x) >= 0) return x;
+        x.swap(y);
+    }
+}
+
+}
 
 
 unsigned char Seven::charToDigit(char c) const {
@@ -27,16 +305,123 @@ void Seven::removeLeadingZeros() {
     }
 }
 
-Seven::Seven() : arraySize(1), dataArray(new unsigned char[1]) {
+std::vector<unsigned char> Seven::digits() const {
+    std::vector<unsigned char> result;
+    if (runArray != nullptr) {
+        result.reserve(arraySize);
+        for (size_t i = 0; i < runCount; ++i) {
+            result.insert(result.end(), runArray[i].length, runArray[i].digit);
+        }
+    } else {
+        result.assign(dataArray, dataArray + arraySize);
+    }
+    trim(result);
+    return result;
+}
+
+Seven Seven::fromDigits(const std::vector<unsigned char>& digits) {
+    if (digits.empty()) return Seven();
+
+    Seven result;
+    delete[] result.dataArray;
+    result.arraySize = digits.size();
+    result.dataArray = new unsigned char[digits.size()];
+    std::copy(digits.begin(), digits.end(), result.dataArray);
+    result.chooseRepresentation();
+
+    return result;
+}
+
+void Seven::appendRun(std::vector<Run>& runs, unsigned char digit, size_t length) {
+    if (length == 0) return;
+
+    if (!runs.empty() && runs.back().digit == digit) {
+        runs.back().length += length;
+    } else {
+        Run run = {digit, length};
+        runs.push_back(run);
+    }
+}
+
+Seven Seven::fromRuns(const std::vector<Run>& runs, size_t size) {
+    Seven result;
+    delete[] result.dataArray;
+    result.dataArray = nullptr;
+    result.arraySize = size;
+    result.runCount = runs.size();
+    result.runArray = new Run[runs.size()];
+    std::copy(runs.begin(), runs.end(), result.runArray);
+
+    result.chooseRepresentation();
+    return result;
+}
+
+bool Seven::worthCompressing(size_t runs) const {
+    return runs > 0 && arraySize / runs >= compressionRatio * sizeof(Run);
+}
+
+void Seven::chooseRepresentation() {
+    if (runArray == nullptr) {
+        if (arraySize == 0) return;
+
+        size_t runs = 1;
+        for (size_t i = 1; i < arraySize; ++i) {
+            if (dataArray[i] != dataArray[i - 1]) {
+                ++runs;
+                if (!worthCompressing(runs)) return;
+            }
+        }
+        if (!worthCompressing(runs)) return;
+
+        runArray = new Run[runs];
+        runCount = 0;
+        for (size_t i = 0; i < arraySize; ++i) {
+            if (runCount > 0 && runArray[runCount - 1].digit == dataArray[i]) {
+                runArray[runCount - 1].length++;
+            } else {
+                runArray[runCount].digit = dataArray[i];
+                runArray[runCount].length = 1;
+                ++runCount;
+            }
+        }
+
+        delete[] dataArray;
+        dataArray = nullptr;
+        return;
+    }
+
+    if (worthCompressing(runCount)) return;
+
+    dataArray = new unsigned char[arraySize];
+    size_t index = 0;
+    for (size_t i = 0; i < runCount; ++i) {
+        std::fill(dataArray + index, dataArray + index + runArray[i].length, runArray[i].digit);
+        index += runArray[i].length;
+    }
+
+    delete[] runArray;
+    runArray = nullptr;
+    runCount = 0;
+}
+
+Seven::Seven() : arraySize(1), dataArray(new unsigned char[1]), runCount(0), runArray(nullptr) {
     dataArray[0] = 0;
 }
 
-Seven::Seven(const size_t& arraySize, unsigned char defaultValue) {
+Seven::Seven(const size_t& arraySize, unsigned char defaultValue)
+    : arraySize(arraySize), dataArray(nullptr), runCount(0), runArray(nullptr) {
     if (defaultValue >= 7) {
         throw std::invalid_argument("digit must be < 7");
     }
     
-    this->arraySize = arraySize;
+    if (worthCompressing(1)) {
+        runCount = 1;
+        runArray = new Run[1];
+        runArray[0].digit = defaultValue;
+        runArray[0].length = arraySize;
+        return;
+    }
+
     this->dataArray = new unsigned char[arraySize];
     
     for (size_t i = 0; i < arraySize; ++i) {
@@ -44,7 +429,7 @@ Seven::Seven(const size_t& arraySize, unsigned char defaultValue) {
     }
 }
 
-Seven::Seven(const std::initializer_list<unsigned char>& initialValues) {
+Seven::Seven(const std::initializer_list<unsigned char>& initialValues) : runCount(0), runArray(nullptr) {
     if (initialValues.size() == 0) {
         throw std::invalid_argument("initializer list cant be empty");
     }
@@ -62,9 +447,10 @@ Seven::Seven(const std::initializer_list<unsigned char>& initialValues) {
     
     std::reverse(dataArray, dataArray + arraySize);
     removeLeadingZeros();
+    chooseRepresentation();
 }
 
-Seven::Seven(const std::string& sourceString) {
+Seven::Seven(const std::string& sourceString) : runCount(0), runArray(nullptr) {
     if (sourceString.empty()) {
         throw std::invalid_argument("empty string");
     }
@@ -80,10 +466,19 @@ Seven::Seven(const std::string& sourceString) {
     }
     
     removeLeadingZeros();
+    chooseRepresentation();
 }
 
-Seven::Seven(const Seven& other) {
+Seven::Seven(const Seven& other) : dataArray(nullptr), runCount(0), runArray(nullptr) {
     arraySize = other.arraySize;
+
+    if (other.runArray != nullptr) {
+        runCount = other.runCount;
+        runArray = new Run[runCount];
+        std::copy(other.runArray, other.runArray + runCount, runArray);
+        return;
+    }
+
     dataArray = new unsigned char[arraySize];
     
     for (size_t i = 0; i < arraySize; ++i) {
@@ -94,12 +489,20 @@ Seven::Seven(const Seven& other) {
 Seven::Seven(Seven&& other) noexcept {
     arraySize = other.arraySize;
     dataArray = other.dataArray;
+    runCount = other.runCount;
+    runArray = other.runArray;
     
     other.arraySize = 0;
     other.dataArray = nullptr;
+    other.runCount = 0;
+    other.runArray = nullptr;
 }
 
 Seven Seven::add(const Seven& other) const {
+    if (runArray != nullptr || other.runArray != nullptr) {
+        return addRuns(other);
+    }
+
     size_t maxSize = std::max(arraySize, other.arraySize);
     unsigned char* resultDigits = new unsigned char[maxSize + 1];
     unsigned char carry = 0;
@@ -118,15 +521,60 @@ Seven Seven::add(const Seven& other) const {
     delete[] result.dataArray;
     result.arraySize = resultSize;
     result.dataArray = resultDigits;
+    result.chooseRepresentation();
     
     return result;
 }
 
+// Внутри отрезка, где обе цифры постоянны, перенос стабилизируется
+// после первого разряда, поэтому отрезок дает не более двух серий
+Seven Seven::addRuns(const Seven& other) const {
+    size_t maxSize = std::max(arraySize, other.arraySize);
+    std::vector<Run> runs;
+    RunCursor a(*this, false);
+    RunCursor b(other, false);
+    unsigned char carry = 0;
+    size_t position = 0;
+
+    while (position < maxSize) {
+        unsigned char da = a.empty() ? 0 : a.digit();
+        unsigned char db = b.empty() ? 0 : b.digit();
+        size_t length = maxSize - position;
+        if (!a.empty()) length = std::min(length, a.length());
+        if (!b.empty()) length = std::min(length, b.length());
+
+        unsigned char sum = da + db + carry;
+        appendRun(runs, sum % 7, 1);
+        carry = sum / 7;
+
+        if (length > 1) {
+            sum = da + db + carry;
+            appendRun(runs, sum % 7, length - 1);
+            carry = sum / 7;
+        }
+
+        a.skip(length);
+        b.skip(length);
+        position += length;
+    }
+
+    if (carry) {
+        appendRun(runs, carry, 1);
+        ++position;
+    }
+
+    return fromRuns(runs, position);
+}
+
 Seven Seven::subtract(const Seven& other) const {
     if (less(other)) {
         throw std::logic_error("cannot subtract larger number from smaller");
     }
 
+    if (runArray != nullptr || other.runArray != nullptr) {
+        return subtractRuns(other);
+    }
+
     unsigned char* resultDigits = new unsigned char[arraySize];
     unsigned char borrow = 0;
     size_t resultSize = arraySize;
@@ -151,16 +599,76 @@ Seven Seven::subtract(const Seven& other) const {
     result.arraySize = resultSize;
     result.dataArray = resultDigits;
     result.removeLeadingZeros();
+    result.chooseRepresentation();
     
     return result;
 }
 
+Seven Seven::subtractRuns(const Seven& other) const {
+    std::vector<Run> runs;
+    RunCursor a(*this, false);
+    RunCursor b(other, false);
+    int borrow = 0;
+    size_t position = 0;
+
+    while (position < arraySize) {
+        int da = a.digit();
+        int db = b.empty() ? 0 : b.digit();
+        size_t length = a.length();
+        if (!b.empty()) length = std::min(length, b.length());
+
+        int diff = da - db - borrow;
+        borrow = diff < 0 ? 1 : 0;
+        appendRun(runs, diff + 7 * borrow, 1);
+
+        if (length > 1) {
+            diff = da - db - borrow;
+            borrow = diff < 0 ? 1 : 0;
+            appendRun(runs, diff + 7 * borrow, length - 1);
+        }
+
+        a.skip(length);
+        b.skip(length);
+        position += length;
+    }
+
+    if (!runs.empty() && runs.back().digit == 0) {
+        size_t zeros = std::min(runs.back().length, position - 1);
+        runs.back().length -= zeros;
+        position -= zeros;
+        if (runs.back().length == 0) runs.pop_back();
+    }
+
+    return fromRuns(runs, position);
+}
+
 Seven Seven::copy() const {
     return Seven(*this);
 }
 
+int Seven::compare(const Seven& other) const {
+    if (arraySize != other.arraySize) return arraySize < other.arraySize ? -1 : 1;
+
+    RunCursor a(*this, true);
+    RunCursor b(other, true);
+
+    while (!a.empty() && !b.empty()) {
+        if (a.digit() != b.digit()) return a.digit() < b.digit() ? -1 : 1;
+
+        size_t length = std::min(a.length(), b.length());
+        a.skip(length);
+        b.skip(length);
+    }
+
+    return 0;
+}
+
 bool Seven::equals(const Seven& other) const {
     if (arraySize != other.arraySize) return false;
+
+    if (runArray != nullptr || other.runArray != nullptr) {
+        return compare(other) == 0;
+    }
     
     for (size_t i = 0; i < arraySize; ++i) {
         if (dataArray[i] != other.dataArray[i]) return false;
@@ -171,6 +679,10 @@ bool Seven::equals(const Seven& other) const {
 
 bool Seven::less(const Seven& other) const {
     if (arraySize != other.arraySize) return arraySize < other.arraySize;
+
+    if (runArray != nullptr || other.runArray != nullptr) {
+        return compare(other) < 0;
+    }
     
     for (size_t i = arraySize; i-- > 0;) {
         if (dataArray[i] != other.dataArray[i]) {
@@ -186,17 +698,50 @@ bool Seven::greater(const Seven& other) const {
 }
 
 std::ostream& Seven::print(std::ostream& outputStream) const {
+    if (runArray != nullptr) {
+        for (size_t i = runCount; i-- > 0;) {
+            char c = digitToChar(runArray[i].digit);
+            for (size_t j = 0; j < runArray[i].length; ++j) {
+                outputStream.put(c);
+            }
+        }
+        return outputStream;
+    }
+
     for (size_t i = arraySize; i-- > 0;) {
         outputStream << digitToChar(dataArray[i]);
     }
     return outputStream;
 }
 
+Seven Seven::gcd(const Seven& other) const {
+    return fromDigits(lehmerGcd(digits(), other.digits()));
+}
+
+Seven Seven::isqrt() const {
+    return fromDigits(newtonSqrt(digits()));
+}
+
+bool Seven::isRunLength() const {
+    return runArray != nullptr;
+}
+
+size_t Seven::storageSize() const {
+    if (runArray != nullptr) return runCount * sizeof(Run);
+    return arraySize;
+}
+
 Seven::~Seven() noexcept {
     if (dataArray != nullptr) {
         delete[] dataArray;
         dataArray = nullptr;
     }
     
+    if (runArray != nullptr) {
+        delete[] runArray;
+        runArray = nullptr;
+    }
+
     arraySize = 0;
-}
\ No newline at end of file
+    runCount = 0;
+}
@@ -71,6 +71,83 @@ TEST(SevenTest, SubtractionThrowsWhenNegative) {
     EXPECT_THROW(a.subtract(b), std::logic_error);
 }
 
+TEST(SevenTest, RepeatedDigitsUseRunLength) {
+    Seven a(1000000000, 6);
+    EXPECT_TRUE(a.isRunLength());
+    EXPECT_LT(a.storageSize(), 1024u);
+
+    Seven b("123");
+    EXPECT_FALSE(b.isRunLength());
+}
+
+TEST(SevenTest, RunLengthAddition) {
+    Seven a(100, 6);
+    Seven b("1");
+    Seven result = a.add(b);
+    EXPECT_TRUE(result.isRunLength());
+    EXPECT_EQ(SevenToString(result), "1" + std::string(100, '0'));
+    EXPECT_TRUE(result.equals(Seven("1" + std::string(100, '0'))));
+}
+
+TEST(SevenTest, RunLengthSubtraction) {
+    Seven a("1" + std::string(100, '0'));
+    Seven b("1");
+    Seven result = a.subtract(b);
+    EXPECT_TRUE(result.isRunLength());
+    EXPECT_TRUE(result.equals(Seven(100, 6)));
+
+    Seven zero = a.subtract(a);
+    EXPECT_EQ(SevenToString(zero), "0");
+    EXPECT_FALSE(zero.isRunLength());
+}
+
+TEST(SevenTest, RunLengthComparison) {
+    std::string digits = std::string(60, '3') + "5" + std::string(60, '3');
+    Seven a(digits);
+    Seven b(121, 3);
+    EXPECT_TRUE(a.isRunLength());
+    EXPECT_TRUE(b.less(a));
+    EXPECT_TRUE(a.greater(b));
+    EXPECT_FALSE(a.equals(b));
+    EXPECT_TRUE(a.equals(Seven(digits)));
+}
+
+TEST(SevenTest, MixedRepresentationArithmetic) {
+    Seven dense("123456");
+    Seven runs(64, 5);
+    Seven sum = runs.add(dense);
+    EXPECT_EQ(SevenToString(sum), std::string(57, '5') + "6012344");
+    EXPECT_TRUE(sum.subtract(dense).equals(runs));
+}
+
+TEST(SevenTest, GcdSmallNumbers) {
+    Seven a("66");  // 48
+    Seven b("44");  // 32
+    EXPECT_EQ(SevenToString(a.gcd(b)), "22");
+    EXPECT_EQ(SevenToString(a.gcd(Seven("0"))), "66");
+    EXPECT_EQ(SevenToString(Seven("0").gcd(Seven("0"))), "0");
+}
+
+TEST(SevenTest, GcdLargeNumbers) {
+    // 7^60 - 1 и 7^40 - 1 имеют общий делитель 7^20 - 1
+    Seven a(60, 6);
+    Seven b(40, 6);
+    EXPECT_TRUE(a.gcd(b).equals(Seven(20, 6)));
+    EXPECT_TRUE(b.gcd(a).equals(Seven(20, 6)));
+}
+
+TEST(SevenTest, IntegerSquareRoot) {
+    EXPECT_EQ(SevenToString(Seven("0").isqrt()), "0");
+    EXPECT_EQ(SevenToString(Seven("100").isqrt()), "10");
+    EXPECT_EQ(SevenToString(Seven("66").isqrt()), "6");
+
+    // (7^50 + 1)^2 = 7^100 + 2 * 7^50 + 1
+    Seven square("1" + std::string(49, '0') + "2" + std::string(49, '0') + "1");
+    Seven root("1" + std::string(49, '0') + "1");
+    EXPECT_TRUE(square.isqrt().equals(root));
+    EXPECT_TRUE(square.subtract(Seven("1")).isqrt().equals(root.subtract(Seven("1"))));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
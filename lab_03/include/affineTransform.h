@@ -0,0 +1,32 @@
+#ifndef AFFINE_TRANSFORM_H
+#define AFFINE_TRANSFORM_H
+
+#include <utility>
+
+// Аффинное преобразование плоскости, матрица 2x3:
+//     x' = a * x + b * y + tx
+//     y' = c * x + d * y + ty
+struct AffineTransform {
+    double a = 1.0;
+    double b = 0.0;
+    double c = 0.0;
+    double d = 1.0;
+    double tx = 0.0;
+    double ty = 0.0;
+
+    static AffineTransform translation(double dx, double dy);
+    static AffineTransform rotation(double angle);
+    static AffineTransform scaling(double sx, double sy);
+
+    // Площадь любой фигуры умножается на |determinant()|
+    double determinant() const;
+
+    std::pair<double, double> apply(const std::pair<double, double>& p) const {
+        return {a * p.first + b * p.second + tx, c * p.first + d * p.second + ty};
+    }
+
+    // Композиция: (m1 * m2)(p) = m1(m2(p))
+    AffineTransform operator*(const AffineTransform& other) const;
+};
+
+#endif
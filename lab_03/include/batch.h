@@ -0,0 +1,27 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "figure.h"
+#include <iostream>
+#include <memory>
+#include <random>
+
+// Неинтерактивный режим lab_03_run:
+//     lab_03_run --batch --count N [--remove K] [--seed S]
+// Генерирует N случайных фигур каждого типа, считает суммарную площадь,
+// поворачивает сцену, удаляет K фигур по случайному индексу и печатает
+// время каждой фазы.
+struct BatchConfig {
+    size_t figuresPerType = 100000;
+    size_t removeCount = 0;
+    unsigned seed = 42;
+};
+
+bool isBatchMode(int argc, char* argv[]);
+BatchConfig parseBatchArgs(int argc, char* argv[]);
+void runBatch(const BatchConfig& config, std::ostream& os);
+
+// Случайная фигура заданного типа (как в createFigure) внутри квадрата [0, extent)
+std::unique_ptr<Figure> randomFigure(int type, std::mt19937& rng, double extent = 1000.0);
+
+#endif
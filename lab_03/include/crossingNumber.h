@@ -0,0 +1,15 @@
+#ifndef CROSSING_NUMBER_H
+#define CROSSING_NUMBER_H
+
+// Пересекает ли ребро ab горизонтальный луч из точки p вправо.
+// Четное число пересечений - точка снаружи. Без деления и ветвлений,
+// поэтому циклы по ребрам и по многоугольникам векторизуются.
+inline bool edgeCrossesRay(double ax, double ay, double bx, double by, double px, double py) {
+    // Знак side совпадает со стороной, с которой лежит p; при ребре вверх
+    // пересечение - если p слева, вниз - если справа
+    double dy = by - ay;
+    double side = (px - ax) * dy - (bx - ax) * (py - ay);
+    return ((ay > py) != (by > py)) & (side * dy < 0.0);
+}
+
+#endif
@@ -1,19 +1,48 @@
 #ifndef FIGURE_H
 #define FIGURE_H
 
+#include "affineTransform.h"
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <utility>
 #include <memory>
 
+// Номера совпадают с типами в меню и в файлах фигур
+enum class FigureType : unsigned char { Trapezoid = 1, Rhombus = 2, Pentagon = 3 };
+
 class Figure {
 public:
     virtual ~Figure() = default;
 
+    // Фигуры размещаются в FigurePool; благодаря виртуальному деструктору
+    // размер при удалении - это размер конкретного типа
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p, std::size_t size) noexcept;
+
+    // Тег задается при создании и не требует виртуального вызова или dynamic_cast
+    FigureType getType() const noexcept {
+        return tag;
+    }
+
+    virtual const char* getName() const = 0;
+    virtual int getVertexCount() const = 0;
     virtual std::pair<double, double> getVertex(int index) const = 0;
     virtual void setVertex(int index, const std::pair<double, double>& v) = 0;
 
-    virtual std::pair<double, double> getCenter() const = 0;
-    virtual double getArea() const = 0;
+    // Площадь и центр кэшируются до следующего изменения вершин
+    std::pair<double, double> getCenter() const;
+    double getArea() const;
+
+    // Хэш типа и вершин, согласован с operator==. Кэшируется, как площадь
+    std::size_t hash() const;
+
+    // Точка внутри фигуры (правило четности, граница не гарантируется)
+    virtual bool contains(const std::pair<double, double>& p) const = 0;
+
+    // Преобразует все вершины. Кэш не сбрасывается: площадь умножается
+    // на |det|, центр преобразуется той же матрицей
+    void transform(const AffineTransform& m);
 
     virtual Figure& operator=(const Figure& other) = 0;
     virtual Figure& operator=(Figure&& other) noexcept = 0;
@@ -27,11 +56,45 @@ public:
     }
 
 protected:
+    explicit Figure(FigureType type) : tag(type) {}
+    Figure(const Figure& other) = default;
+
+    virtual std::pair<double, double> computeCenter() const = 0;
+    virtual double computeArea() const = 0;
+    virtual std::size_t computeHash() const = 0;
+
+    // Вызывается наследниками при любом изменении вершин
+    void invalidateCache() noexcept;
+
+    // Меняет вершины без сброса кэша, его обновляет transform()
+    virtual void transformVertices(const AffineTransform& m) = 0;
+
     virtual void printVertices(std::ostream& os) const = 0;
     virtual void readVertices(std::istream& is) = 0;
+
+private:
+    const FigureType tag;
+    mutable bool cacheValid = false;
+    mutable bool hashValid = false;
+    mutable std::size_t cachedHash = 0;
+    mutable double cachedArea = 0.0;
+    mutable std::pair<double, double> cachedCenter{0.0, 0.0};
+
+    void updateCache() const;
 };
 
 std::ostream& operator<<(std::ostream& os, const Figure& fig);
 std::istream& operator>>(std::istream& is, Figure& fig);
 
+namespace std {
+
+template <>
+struct hash<Figure> {
+    size_t operator()(const Figure& fig) const {
+        return fig.hash();
+    }
+};
+
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef FIGURE_COLLECTION_H
+#define FIGURE_COLLECTION_H
+
+#include "figure.h"
+#include "rtree.h"
+#include "slotMap.h"
+#include <memory>
+#include <vector>
+
+using FigureHandle = Handle;
+
+// Набор фигур, поддерживающий суммарную площадь при добавлении и удалении.
+// Фигуры доступны только для чтения, поэтому сумма всегда актуальна.
+// Каждая фигура получает устойчивый дескриптор; удаление по нему - O(1),
+// но переставляет последнюю фигуру на место удаленной.
+class FigureCollection {
+public:
+    FigureHandle add(std::unique_ptr<Figure> fig);
+    void remove(const FigureHandle& handle);
+    void clear();
+
+    bool contains(const FigureHandle& handle) const;
+    const Figure& operator[](const FigureHandle& handle) const;
+
+    // Плотный обход: позиция фигуры меняется после удаления других
+    const Figure& operator[](size_t position) const;
+    FigureHandle handleAt(size_t position) const;
+    size_t size() const;
+    bool empty() const;
+
+    // Аффинное преобразование всех или только перечисленных фигур.
+    // Площади и суммарная площадь обновляются через определитель матрицы.
+    void transform(const AffineTransform& m);
+    void transform(const std::vector<FigureHandle>& handles, const AffineTransform& m);
+
+    // O(1): накопленная сумма с компенсацией ошибки округления (Кэхэн)
+    double getTotalArea() const;
+
+    // Пространственные запросы: кандидаты из R-дерева по ограничивающим
+    // прямоугольникам уточняются точной проверкой многоугольника.
+    // Индекс строится при первом запросе и дальше обновляется при add/remove.
+    std::vector<const Figure*> queryWindow(const BoundingBox& box) const;
+    std::vector<const Figure*> queryPoint(const Point2D& p) const;
+
+private:
+    SlotMap<std::unique_ptr<Figure>> figures;
+    double totalArea = 0.0;
+    double compensation = 0.0;
+    mutable std::unique_ptr<RTree<const Figure*>> spatialIndex;
+
+    void accumulate(double value);
+    const RTree<const Figure*>& index() const;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef FIGURE_LOADER_H
+#define FIGURE_LOADER_H
+
+#include "figureStore.h"
+#include "figureCollection.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// Массовая загрузка фигур из файлов без приглашений к вводу.
+//
+// Текстовый формат: одна фигура на строку, сначала тип (1 - трапеция,
+// 2 - ромб, 3 - пятиугольник, как в меню), затем координаты вершин:
+//     2 0 0 2 0 3 1 1 1
+// Пустые строки и строки, начинающиеся с '#', пропускаются.
+//
+// Двоичный формат: заголовок FigureFileHeader и массив FigureRecord
+// фиксированного размера. Файл отображается в память и читается без копирования.
+
+struct FigureFileHeader {
+    char magic[4];          // "FIG3"
+    std::uint32_t version;  // 1
+    std::uint64_t count;
+};
+
+struct FigureRecord {
+    std::uint32_t kind;     // FigureStore::Kind (FigureType)
+    std::uint32_t reserved;
+    double coords[10];      // x1 y1 x2 y2 ...; лишние координаты равны нулю
+};
+
+class MappedFigureFile {
+public:
+    explicit MappedFigureFile(const std::string& path);
+    ~MappedFigureFile();
+
+    MappedFigureFile(const MappedFigureFile&) = delete;
+    MappedFigureFile& operator=(const MappedFigureFile&) = delete;
+
+    size_t size() const;
+    const FigureRecord& operator[](size_t index) const;
+    const FigureRecord* begin() const;
+    const FigureRecord* end() const;
+
+private:
+    void* mapping = nullptr;
+    size_t length = 0;
+    const FigureRecord* records = nullptr;
+    size_t count = 0;
+};
+
+size_t loadText(std::istream& is, FigureStore& store);
+size_t loadText(std::istream& is, FigureCollection& figures);
+size_t loadBinary(const std::string& path, FigureStore& store);
+size_t loadBinary(const std::string& path, FigureCollection& figures);
+
+// Определяет формат по сигнатуре файла
+size_t loadFigures(const std::string& path, FigureStore& store);
+size_t loadFigures(const std::string& path, FigureCollection& figures);
+
+void saveText(std::ostream& os, const FigureStore& store);
+void saveBinary(const std::string& path, const FigureStore& store);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef FIGURE_POOL_H
+#define FIGURE_POOL_H
+
+#include <cstddef>
+
+// Пул блоков одного размера. Память берется страницами, блоки выдаются
+// подряд, освобожденные блоки попадают в список свободных. Без блокировок:
+// синхронизацию добавляет FigurePool.
+class FixedPool {
+public:
+    static constexpr size_t pageSize = 64 * 1024;
+
+    constexpr explicit FixedPool(size_t blockSize) : blockSize(blockSize) {}
+
+    void* allocate();
+    void deallocate(void* p) noexcept;
+
+    // Возвращает все страницы, если в пуле не осталось живых блоков
+    bool release() noexcept;
+
+    size_t liveCount() const { return live; }
+    size_t pageCount() const { return pages; }
+
+private:
+    struct Page {
+        Page* next;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t blockSize;
+    Page* pageList = nullptr;
+    FreeBlock* freeList = nullptr;
+    char* cursor = nullptr;
+    char* pageEnd = nullptr;
+    size_t live = 0;
+    size_t pages = 0;
+};
+
+// Пулы для фигур с классами размеров через 16 байт: объекты одного типа
+// лежат плотно на общих страницах. Используются из Figure::operator new,
+// поэтому std::unique_ptr<Figure> с обычным удалителем работает как прежде.
+// Каждый класс размеров защищен своим мьютексом, поэтому фигуры можно
+// создавать и удалять из нескольких потоков, в том числе удалять не в том
+// потоке, где они созданы. Сам FixedPool не потокобезопасен.
+namespace FigurePool {
+
+void* allocate(size_t size);
+void deallocate(void* p, size_t size) noexcept;
+
+// Число живых фигур и занятых страниц во всех пулах
+size_t liveCount();
+size_t pageCount();
+
+// Освобождает страницы пустых пулов за O(страниц)
+void release() noexcept;
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FIGURE_STORE_H
+#define FIGURE_STORE_H
+
+#include "figure.h"
+#include <cstddef>
+#include <vector>
+
+// Хранилище фигур в виде структуры массивов: фигуры с одинаковым числом
+// вершин лежат в одной группе, координата k-й вершины всех фигур группы -
+// в отдельном непрерывном массиве. Площади и центры считаются сразу для
+// всей группы без виртуальных вызовов.
+class FigureStore {
+public:
+    // Тег фигуры; номера совпадают с номерами типов в меню createFigure
+    using Kind = FigureType;
+
+    static size_t vertexCount(Kind kind);
+
+    void add(const Figure& fig);
+    void add(Kind kind, const std::pair<double, double>* vertices);
+    void reserve(Kind kind, size_t count);
+    void clear();
+
+    size_t size() const;
+    Kind getKind(size_t index) const;
+    std::pair<double, double> getVertex(size_t index, int vertex) const;
+    std::unique_ptr<Figure> get(size_t index) const;
+
+    // Аффинное преобразование всех фигур или фигур с данными индексами
+    void transform(const AffineTransform& m);
+    void transform(const std::vector<size_t>& indices, const AffineTransform& m);
+
+    double getTotalArea() const;
+    std::vector<double> getAreas() const;
+    std::vector<std::pair<double, double>> getCenters() const;
+
+private:
+    struct Group {
+        size_t vertexCount;
+        std::vector<std::vector<double>> xs;  // xs[k][i] - x k-й вершины i-й фигуры группы
+        std::vector<std::vector<double>> ys;
+        std::vector<Kind> kinds;
+        std::vector<size_t> indices;          // Индекс фигуры в порядке добавления
+    };
+
+    struct Location {
+        size_t group;
+        size_t offset;
+    };
+
+    Group groups[2] = {{4, std::vector<std::vector<double>>(4), std::vector<std::vector<double>>(4), {}, {}},
+                       {5, std::vector<std::vector<double>>(5), std::vector<std::vector<double>>(5), {}, {}}};
+    std::vector<Location> locations;
+
+    static size_t groupIndex(Kind kind);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef FIGURE_UTILS_H
+#define FIGURE_UTILS_H
+
+#include "figure.h"
+#include "figureVariant.h"
+#include "figureCollection.h"
+#include <memory>
+#include <vector>
+
+std::unique_ptr<Figure> createFigure(int type);
+std::unique_ptr<Figure> createFigure(int type, const std::pair<double, double>* vertices);
+
+void printFigureInfo(const Figure& fig);
+void printFigureInfo(const FigureVariant& fig);
+
+// Параллельная попарная сумма: результат не зависит от числа потоков
+// (threads = 0 - по числу ядер)
+double getTotalArea(const std::vector<std::unique_ptr<Figure>>& figures, unsigned threads = 0);
+double getTotalArea(const std::vector<FigureVariant>& figures, unsigned threads = 0);
+double getTotalArea(const FigureCollection& figures);
+
+void removeFigure(std::vector<std::unique_ptr<Figure>>& figures, int index);
+void removeFigure(FigureCollection& figures, const FigureHandle& handle);
+
+// Хэш и равенство по указателю, для std::unordered_set<const Figure*, FigureHash, FigureEqual>
+struct FigureHash {
+    size_t operator()(const Figure* fig) const {
+        return fig->hash();
+    }
+};
+
+struct FigureEqual {
+    bool operator()(const Figure* a, const Figure* b) const {
+        return *a == *b;
+    }
+};
+
+// Удаляет повторы (тот же тип и те же вершины), оставляя первое вхождение.
+// Через хэш-таблицу, за линейное время. Возвращает число удаленных фигур
+size_t removeDuplicates(std::vector<std::unique_ptr<Figure>>& figures);
+size_t removeDuplicates(FigureCollection& figures);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef FIGURE_VARIANT_H
+#define FIGURE_VARIANT_H
+
+#include "trapezoid.h"
+#include "rhombus.h"
+#include "pentagon.h"
+#include <variant>
+#include <vector>
+
+// Закрытый набор фигур без виртуальной диспетчеризации: площадь, центр,
+// сравнение и присваивание вызываются у конкретного типа через std::visit.
+// Сравнение и присваивание std::variant используют невиртуальные
+// Trapezoid::operator== / operator=(const Trapezoid&) и т.д.
+using FigureVariant = std::variant<Trapezoid, Rhombus, Pentagon>;
+
+double getArea(const FigureVariant& fig);
+std::pair<double, double> getCenter(const FigureVariant& fig);
+std::pair<double, double> getVertex(const FigureVariant& fig, int index);
+
+FigureVariant toVariant(const Figure& fig);
+std::unique_ptr<Figure> toFigure(const FigureVariant& fig);
+
+std::ostream& operator<<(std::ostream& os, const FigureVariant& fig);
+
+#endif
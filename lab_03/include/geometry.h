@@ -0,0 +1,45 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "figure.h"
+#include <utility>
+
+using Point2D = std::pair<double, double>;
+
+struct BoundingBox {
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+
+    // Встроены: вызываются на каждом узле при обходе R-дерева
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    bool contains(const Point2D& p) const {
+        return p.first >= minX && p.first <= maxX && p.second >= minY && p.second <= maxY;
+    }
+
+    BoundingBox merged(const BoundingBox& other) const;
+    double area() const;
+};
+
+// Максимальное число вершин среди фигур lab_03
+const int maxVertexCount = 5;
+
+BoundingBox getBoundingBox(const Point2D* vertices, int count);
+BoundingBox getBoundingBox(const Figure& fig);
+
+// Точные проверки для многоугольника (правило четности пересечений)
+bool polygonContains(const Point2D* vertices, int count, const Point2D& p);
+bool polygonIntersectsBox(const Point2D* vertices, int count, const BoundingBox& box);
+
+// Пересечение с учетом касания и наложения коллинеарных отрезков
+bool segmentsIntersect(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d);
+bool polygonsIntersect(const Point2D* a, int countA, const Point2D* b, int countB);
+
+bool figureContains(const Figure& fig, const Point2D& p);
+bool figureIntersectsBox(const Figure& fig, const BoundingBox& box);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef OVERLAP_H
+#define OVERLAP_H
+
+#include "figureCollection.h"
+#include "figureStore.h"
+#include <utility>
+#include <vector>
+
+// Все пары фигур, имеющих хотя бы одну общую точку (касание тоже считается).
+// Кандидаты берутся из R-дерева по ограничивающим прямоугольникам,
+// затем проверяются точно. Для FigureStore - индексы (first < second).
+std::vector<std::pair<size_t, size_t>> findOverlappingPairs(const FigureStore& store);
+std::vector<std::pair<FigureHandle, FigureHandle>> findOverlappingPairs(const FigureCollection& figures);
+
+// Площадь объединения: перекрытия учитываются один раз. Считается по формуле
+// Грина вдоль участков ребер, не покрытых другими фигурами, поэтому работа
+// зависит только от локальной плотности, а не от размера связных групп.
+// Фигуры должны быть простыми (без самопересечений) многоугольниками.
+double getUnionArea(const FigureStore& store);
+double getUnionArea(const FigureCollection& figures);
+
+#endif
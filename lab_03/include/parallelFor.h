@@ -0,0 +1,36 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Вызывает body(begin, end) для блоков [0, count) размера blockSize в
+// нескольких потоках; потоки забирают блоки по очереди. threads = 0 - по
+// числу ядер. Разбиение на блоки не зависит от числа потоков.
+template <typename Body>
+void parallelFor(size_t count, size_t blockSize, const Body& body, unsigned threads = 0) {
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    std::atomic<size_t> nextBlock{0};
+
+    auto worker = [&]() {
+        for (size_t block = nextBlock++; block < blocks; block = nextBlock++) {
+            size_t begin = block * blockSize;
+            body(begin, std::min(count, begin + blockSize));
+        }
+    };
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t workers = std::min<size_t>(threads, blocks);
+    size_t helpers = workers > 0 ? workers - 1 : 0;  // Текущий поток тоже считает
+
+    std::vector<std::thread> pool;
+    pool.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool) thread.join();
+}
+
+#endif
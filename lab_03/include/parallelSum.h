@@ -0,0 +1,46 @@
+#ifndef PARALLEL_SUM_H
+#define PARALLEL_SUM_H
+
+#include "parallelFor.h"
+#include <cstddef>
+#include <vector>
+
+namespace parallelSumDetail {
+
+// Размер блока не зависит от числа потоков - от этого зависит воспроизводимость
+const size_t blockSize = 4096;
+const size_t leafSize = 8;
+
+// Попарное суммирование: ошибка округления растет как O(log n)
+template <typename Value>
+double pairwise(const Value& value, size_t begin, size_t end) {
+    if (end - begin <= leafSize) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i) sum += value(i);
+        return sum;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    return pairwise(value, begin, middle) + pairwise(value, middle, end);
+}
+
+}
+
+// Сумма value(0) + ... + value(count - 1) в нескольких потоках.
+// Диапазон делится на блоки фиксированного размера, блоки и затем их суммы
+// складываются попарно в одном и том же порядке, поэтому результат побитово
+// одинаков при любом числе потоков. threads = 0 - по числу ядер.
+// value вызывается из разных потоков для разных i.
+template <typename Value>
+double parallelSum(size_t count, const Value& value, unsigned threads = 0) {
+    using namespace parallelSumDetail;
+
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    std::vector<double> blockSums(blocks);
+    parallelFor(count, blockSize, [&](size_t begin, size_t end) {
+        blockSums[begin / blockSize] = pairwise(value, begin, end);
+    }, threads);
+
+    return pairwise([&blockSums](size_t i) { return blockSums[i]; }, 0, blocks);
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef POINT_LOCATOR_H
+#define POINT_LOCATOR_H
+
+#include "figureCollection.h"
+#include "figureStore.h"
+#include "geometry.h"
+#include <cstdint>
+#include <vector>
+
+// Пакетная проверка точек по снимку набора фигур. Фигуры раскладываются по
+// ячейкам равномерной сетки по ограничивающим прямоугольникам; в ячейке
+// вершины лежат структурой массивов (четырехугольники дополнены до пяти
+// вершин повтором последней), и точка проверяется сразу по всем кандидатам
+// векторизуемым циклом. Массивы точек обрабатываются блоками в нескольких потоках.
+// Номера фигур - позиции в FigureStore или плотные позиции FigureCollection.
+class PointLocator {
+public:
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    explicit PointLocator(const FigureStore& store);
+    explicit PointLocator(const FigureCollection& figures);
+
+    size_t size() const { return figureCount; }
+
+    // Фигура с наибольшим номером (верхняя при отрисовке), содержащая p, или none
+    size_t locate(const Point2D& p) const;
+    std::vector<size_t> locate(const std::vector<Point2D>& points, unsigned threads = 0) const;
+
+    // Сколько фигур содержит каждую точку
+    std::vector<std::uint32_t> countContaining(const std::vector<Point2D>& points, unsigned threads = 0) const;
+
+private:
+    static constexpr int slots = maxVertexCount;
+
+    size_t figureCount = 0;
+    BoundingBox bounds;
+    size_t columns = 0;
+    size_t rows = 0;
+    double scaleX = 0.0;  // Ячеек на единицу длины
+    double scaleY = 0.0;
+
+    // Ячейка c занимает записи [cellStart[c], cellStart[c + 1]), по возрастанию номера фигуры
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint32_t> entryFigure;
+    std::vector<double> entryX[slots];
+    std::vector<double> entryY[slots];
+
+    void build(const std::vector<std::vector<Point2D>>& polygons);
+    bool cellOf(const Point2D& p, size_t& cell) const;
+
+    // inside[e - begin] = точка внутри фигуры записи e
+    void testCell(size_t cell, const Point2D& p, unsigned char* inside) const;
+};
+
+#endif
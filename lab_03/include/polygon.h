@@ -0,0 +1,161 @@
+#ifndef POLYGON_H
+#define POLYGON_H
+
+#include "figure.h"
+#include "crossingNumber.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+// Общая реализация многоугольника с N вершинами. Derived - конкретная фигура,
+// она задает имя (Derived::name), тег (Derived::type) и вершины по умолчанию. Площадь и центр
+// разворачиваются во время компиляции, без циклов и проверок индексов.
+template <typename Derived, int N>
+class Polygon : public Figure {
+public:
+    static constexpr int vertexCount = N;
+
+    using Vertices = std::array<std::pair<double, double>, N>;
+
+    const char* getName() const override {
+        return Derived::name;
+    }
+
+    int getVertexCount() const override {
+        return N;
+    }
+
+    std::pair<double, double> getVertex(int index) const override {
+        if (index < 0 || index >= N) throw std::out_of_range("Invalid vertex index");
+        return vertices[index];
+    }
+
+    void setVertex(int index, const std::pair<double, double>& v) override {
+        if (index < 0 || index >= N) throw std::out_of_range("Invalid vertex index");
+        vertices[index] = v;
+        invalidateCache();
+    }
+
+    bool contains(const std::pair<double, double>& p) const override {
+        return crossings(p, std::make_integer_sequence<int, N>()) & 1;
+    }
+
+    // Доступ без проверки: индекс проверяется при компиляции
+    template <int I>
+    const std::pair<double, double>& vertex() const {
+        static_assert(I >= 0 && I < N, "Invalid vertex index");
+        return vertices[I];
+    }
+
+    bool operator==(const Derived& other) const {
+        return vertices == other.vertices;
+    }
+
+    // Конкретные фигуры final, поэтому совпадение тега означает тип Derived
+    Figure& operator=(const Figure& other) override {
+        if (this != &other) {
+            if (other.getType() != Derived::type) throw std::invalid_argument("Cannot assign different figure type");
+            assign(static_cast<const Polygon&>(other).vertices);
+        }
+        return *this;
+    }
+
+    Figure& operator=(Figure&& other) noexcept override {
+        if (this != &other && other.getType() == Derived::type) {
+            assign(static_cast<const Polygon&>(other).vertices);
+        }
+        return *this;
+    }
+
+    bool operator==(const Figure& other) const override {
+        return other.getType() == Derived::type && vertices == static_cast<const Polygon&>(other).vertices;
+    }
+
+    void printVertices(std::ostream& os) const override {
+        os << Derived::name << ": ";
+        for (int i = 0; i < N; ++i) {
+            if (i > 0) os << ", ";
+            os << "(" << vertices[i].first << ", " << vertices[i].second << ")";
+        }
+    }
+
+    void readVertices(std::istream& is) override {
+        for (auto& v : vertices) {
+            is >> v.first >> v.second;
+        }
+        invalidateCache();
+    }
+
+protected:
+    explicit Polygon(const Vertices& v) : Figure(Derived::type), vertices(v) {}
+    Polygon(const Polygon& other) = default;
+
+    // Явно: неявное присваивание вызвало бы чисто виртуальный Figure::operator=
+    Polygon& operator=(const Polygon& other) {
+        if (this != &other) assign(other.vertices);
+        return *this;
+    }
+
+    std::pair<double, double> computeCenter() const override {
+        return center(std::make_integer_sequence<int, N>());
+    }
+
+    double computeArea() const override {
+        return std::abs(doubledArea(std::make_integer_sequence<int, N>())) / 2.0;
+    }
+
+    std::size_t computeHash() const override {
+        std::uint64_t h = static_cast<std::uint64_t>(Derived::type);
+        for (const auto& v : vertices) {
+            h = mixHash(h, v.first);
+            h = mixHash(h, v.second);
+        }
+        return static_cast<std::size_t>(h ^ (h >> 31));
+    }
+
+    void transformVertices(const AffineTransform& m) override {
+        for (auto& v : vertices) {
+            v = m.apply(v);
+        }
+    }
+
+private:
+    Vertices vertices;
+
+    void assign(const Vertices& v) {
+        invalidateCache();
+        vertices = v;
+    }
+
+    // -0.0 == 0.0, поэтому оба нуля хэшируются одинаково (x + 0.0 дает +0.0)
+    static std::uint64_t mixHash(std::uint64_t h, double x) {
+        x += 0.0;
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        h = (h ^ bits) * 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 29);
+    }
+
+    template <int... I>
+    double doubledArea(std::integer_sequence<int, I...>) const {
+        return ((vertices[I].first * vertices[(I + 1) % N].second -
+                 vertices[(I + 1) % N].first * vertices[I].second) + ...);
+    }
+
+    template <int... I>
+    int crossings(const std::pair<double, double>& p, std::integer_sequence<int, I...>) const {
+        return (edgeCrossesRay(vertices[I].first, vertices[I].second,
+                               vertices[(I + 1) % N].first, vertices[(I + 1) % N].second,
+                               p.first, p.second) + ...);
+    }
+
+    template <int... I>
+    std::pair<double, double> center(std::integer_sequence<int, I...>) const {
+        return {(vertices[I].first + ...) / N, (vertices[I].second + ...) / N};
+    }
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include "figure.h"
+#include "figureCollection.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+enum class ReportFormat {
+    Human,      // Как printFigureInfo
+    Csv,        // id,type,area,center_x,center_y,x1,y1,...,x5,y5
+    JsonLines   // Один объект JSON на строку
+};
+
+// Отчет о фигурах. Текст собирается в буфере через std::to_chars и
+// уходит в поток блоками по мегабайту; сброс - в flush() и деструкторе.
+// В CSV и JSON числа записываются без потери точности.
+class ReportWriter {
+public:
+    explicit ReportWriter(std::ostream& os, ReportFormat format = ReportFormat::Human);
+    ~ReportWriter();
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    void write(const Figure& fig);
+    void write(const Figure& fig, const FigureHandle& id);
+    void write(const FigureCollection& figures);
+    void flush();
+
+private:
+    std::ostream& os;
+    ReportFormat format;
+    std::string buffer;
+    bool headerWritten = false;
+
+    void writeRecord(const Figure& fig, const FigureHandle* id);
+    void writeHuman(const Figure& fig, const FigureHandle* id);
+    void writeCsv(const Figure& fig, const FigureHandle* id);
+    void writeJson(const Figure& fig, const FigureHandle* id);
+
+    void append(const char* text);
+    void appendNumber(double value);
+    void appendNumber(std::uint32_t value);
+    void appendId(const FigureHandle& id);
+};
+
+// Формат по имени: human, csv или jsonl
+ReportFormat parseReportFormat(const std::string& name);
+
+#endif
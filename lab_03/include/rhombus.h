@@ -1,31 +1,22 @@
 #ifndef RHOMBUS_H
 #define RHOMBUS_H
 
-#include "figure.h"
-
-class Rhombus : public Figure {
-private:
-    std::pair<double, double> vertices[4];
+#include "polygon.h"
 
+class Rhombus final : public Polygon<Rhombus, 4> {
 public:
+    static constexpr const char* name = "Rhombus";
+    static constexpr FigureType type = FigureType::Rhombus;
+
     Rhombus();
     Rhombus(const std::pair<double, double>& v1,
-              const std::pair<double, double>& v2,
-              const std::pair<double, double>& v3,
-              const std::pair<double, double>& v4);
-
-    std::pair<double, double> getVertex(int index) const override;
-    void setVertex(int index, const std::pair<double, double>& v) override;
-
-    std::pair<double, double> getCenter() const override;
-    double getArea() const override;
-
-    Figure& operator=(const Figure& other) override;
-    Figure& operator=(Figure&& other) noexcept override;
-    bool operator==(const Figure& other) const override;
+            const std::pair<double, double>& v2,
+            const std::pair<double, double>& v3,
+            const std::pair<double, double>& v4);
+    Rhombus(const Rhombus& other) = default;
 
-    void printVertices(std::ostream& os) const override;
-    void readVertices(std::istream& is) override;
+    using Polygon::operator=;
+    Rhombus& operator=(const Rhombus& other) = default;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+#ifndef RTREE_H
+#define RTREE_H
+
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// R-дерево над ограничивающими прямоугольниками. Строится пакетно
+// (Sort-Tile-Recursive) и поддерживает вставку и удаление по одному.
+// Key - идентификатор объекта, сравнимый через ==.
+template <typename Key>
+class RTree {
+public:
+    struct Item {
+        BoundingBox box;
+        Key key;
+    };
+
+    void bulkLoad(std::vector<Item> items);
+    void insert(const BoundingBox& box, const Key& key);
+    bool remove(const BoundingBox& box, const Key& key);
+    void clear();
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int height() const;
+
+    // Вызывает visit(key, box) для всех объектов, прямоугольник которых пересекает box
+    template <typename Visitor>
+    void query(const BoundingBox& box, Visitor visit) const {
+        if (root) queryNode(*root, box, visit);
+    }
+
+    std::vector<Key> query(const BoundingBox& box) const;
+    std::vector<Key> queryPoint(const Point2D& p) const;
+
+private:
+    static constexpr size_t maxEntries = 16;
+    static constexpr size_t minEntries = 4;
+
+    struct Node;
+
+    struct Entry {
+        BoundingBox box;
+        std::unique_ptr<Node> child;
+        Key key{};
+    };
+
+    struct Node {
+        bool leaf = true;
+        std::vector<Entry> entries;
+    };
+
+    std::unique_ptr<Node> root;
+    size_t count = 0;
+
+    static BoundingBox nodeBox(const Node& node);
+    static Point2D center(const BoundingBox& box);
+    static std::vector<Entry> pack(std::vector<Entry> entries, bool leaf);
+    static std::unique_ptr<Node> split(Node& node);
+    static size_t chooseSubtree(const Node& node, const BoundingBox& box);
+    static std::unique_ptr<Node> insertEntry(Node& node, Entry entry);
+    static bool removeEntry(Node& node, const BoundingBox& box, const Key& key, std::vector<Item>& orphans);
+    static void collectItems(Node& node, std::vector<Item>& items);
+
+    void insertItem(const BoundingBox& box, const Key& key);
+
+    template <typename Visitor>
+    static void queryNode(const Node& node, const BoundingBox& box, Visitor& visit) {
+        for (const Entry& entry : node.entries) {
+            if (!entry.box.intersects(box)) continue;
+            if (node.leaf) {
+                visit(entry.key, entry.box);
+            } else {
+                queryNode(*entry.child, box, visit);
+            }
+        }
+    }
+};
+
+template <typename Key>
+BoundingBox RTree<Key>::nodeBox(const Node& node) {
+    BoundingBox box = node.entries.front().box;
+    for (const Entry& entry : node.entries) {
+        box = box.merged(entry.box);
+    }
+    return box;
+}
+
+template <typename Key>
+Point2D RTree<Key>::center(const BoundingBox& box) {
+    return {(box.minX + box.maxX) / 2.0, (box.minY + box.maxY) / 2.0};
+}
+
+template <typename Key>
+std::vector<typename RTree<Key>::Entry> RTree<Key>::pack(std::vector<Entry> entries, bool leaf) {
+    size_t nodeCount = (entries.size() + maxEntries - 1) / maxEntries;
+    size_t sliceCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodeCount))));
+    size_t sliceSize = sliceCount * maxEntries;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return center(a.box).first < center(b.box).first;
+    });
+
+    std::vector<Entry> parents;
+    parents.reserve(nodeCount);
+    for (size_t slice = 0; slice < entries.size(); slice += sliceSize) {
+        auto sliceBegin = entries.begin() + slice;
+        auto sliceEnd = entries.begin() + std::min(entries.size(), slice + sliceSize);
+        std::sort(sliceBegin, sliceEnd, [](const Entry& a, const Entry& b) {
+            return center(a.box).second < center(b.box).second;
+        });
+
+        for (auto it = sliceBegin; it < sliceEnd;) {
+            auto last = it + std::min<size_t>(maxEntries, sliceEnd - it);
+            auto node = std::make_unique<Node>();
+            node->leaf = leaf;
+            node->entries.assign(std::make_move_iterator(it), std::make_move_iterator(last));
+            it = last;
+
+            Entry parent;
+            parent.box = nodeBox(*node);
+            parent.child = std::move(node);
+            parents.push_back(std::move(parent));
+        }
+    }
+    return parents;
+}
+
+template <typename Key>
+void RTree<Key>::bulkLoad(std::vector<Item> items) {
+    clear();
+    if (items.empty()) return;
+
+    std::vector<Entry> level;
+    level.reserve(items.size());
+    for (Item& item : items) {
+        Entry entry;
+        entry.box = item.box;
+        entry.key = std::move(item.key);
+        level.push_back(std::move(entry));
+    }
+    count = level.size();
+
+    level = pack(std::move(level), true);
+    while (level.size() > 1) {
+        level = pack(std::move(level), false);
+    }
+    root = std::move(level.front().child);
+}
+
+template <typename Key>
+void RTree<Key>::insert(const BoundingBox& box, const Key& key) {
+    insertItem(box, key);
+    ++count;
+}
+
+template <typename Key>
+void RTree<Key>::insertItem(const BoundingBox& box, const Key& key) {
+    if (!root) root = std::make_unique<Node>();
+
+    Entry entry;
+    entry.box = box;
+    entry.key = key;
+
+    std::unique_ptr<Node> sibling = insertEntry(*root, std::move(entry));
+    if (sibling) {
+        auto newRoot = std::make_unique<Node>();
+        newRoot->leaf = false;
+
+        Entry left;
+        left.box = nodeBox(*root);
+        left.child = std::move(root);
+        Entry right;
+        right.box = nodeBox(*sibling);
+        right.child = std::move(sibling);
+
+        newRoot->entries.push_back(std::move(left));
+        newRoot->entries.push_back(std::move(right));
+        root = std::move(newRoot);
+    }
+}
+
+template <typename Key>
+size_t RTree<Key>::chooseSubtree(const Node& node, const BoundingBox& box) {
+    size_t best = 0;
+    double bestGrowth = 0.0;
+    double bestArea = 0.0;
+    for (size_t i = 0; i < node.entries.size(); ++i) {
+        double area = node.entries[i].box.area();
+        double growth = node.entries[i].box.merged(box).area() - area;
+        if (i == 0 || growth < bestGrowth || (growth == bestGrowth && area < bestArea)) {
+            best = i;
+            bestGrowth = growth;
+            bestArea = area;
+        }
+    }
+    return best;
+}
+
+template <typename Key>
+std::unique_ptr<typename RTree<Key>::Node> RTree<Key>::insertEntry(Node& node, Entry entry) {
+    if (node.leaf) {
+        node.entries.push_back(std::move(entry));
+    } else {
+        size_t index = chooseSubtree(node, entry.box);
+        Entry& target = node.entries[index];
+        std::unique_ptr<Node> sibling = insertEntry(*target.child, std::move(entry));
+        target.box = nodeBox(*target.child);
+
+        if (sibling) {
+            Entry extra;
+            extra.box = nodeBox(*sibling);
+            extra.child = std::move(sibling);
+            node.entries.push_back(std::move(extra));
+        }
+    }
+
+    if (node.entries.size() > maxEntries) return split(node);
+    return nullptr;
+}
+
+// Делит узел пополам по оси с наибольшим разбросом центров
+template <typename Key>
+std::unique_ptr<typename RTree<Key>::Node> RTree<Key>::split(Node& node) {
+    Point2D first = center(node.entries.front().box);
+    BoundingBox spread = {first.first, first.second, first.first, first.second};
+    for (const Entry& entry : node.entries) {
+        Point2D c = center(entry.box);
+        spread = spread.merged({c.first, c.second, c.first, c.second});
+    }
+    bool byX = spread.maxX - spread.minX >= spread.maxY - spread.minY;
+
+    std::sort(node.entries.begin(), node.entries.end(), [byX](const Entry& a, const Entry& b) {
+        return byX ? center(a.box).first < center(b.box).first
+                   : center(a.box).second < center(b.box).second;
+    });
+
+    auto sibling = std::make_unique<Node>();
+    sibling->leaf = node.leaf;
+    auto middle = node.entries.begin() + node.entries.size() / 2;
+    sibling->entries.assign(std::make_move_iterator(middle), std::make_move_iterator(node.entries.end()));
+    node.entries.erase(middle, node.entries.end());
+    return sibling;
+}
+
+template <typename Key>
+bool RTree<Key>::remove(const BoundingBox& box, const Key& key) {
+    if (!root) return false;
+
+    std::vector<Item> orphans;
+    if (!removeEntry(*root, box, key, orphans)) return false;
+    --count;
+
+    while (!root->leaf && root->entries.size() == 1) {
+        std::unique_ptr<Node> child = std::move(root->entries.front().child);
+        root = std::move(child);
+    }
+    if (root->entries.empty()) root.reset();
+
+    for (const Item& item : orphans) {
+        insertItem(item.box, item.key);
+    }
+    return true;
+}
+
+// Недозаполненные узлы удаляются, их объекты вставляются заново
+template <typename Key>
+bool RTree<Key>::removeEntry(Node& node, const BoundingBox& box, const Key& key, std::vector<Item>& orphans) {
+    for (size_t i = 0; i < node.entries.size(); ++i) {
+        Entry& entry = node.entries[i];
+        if (!entry.box.intersects(box)) continue;
+
+        if (node.leaf) {
+            if (entry.key == key) {
+                node.entries.erase(node.entries.begin() + i);
+                return true;
+            }
+            continue;
+        }
+
+        if (!removeEntry(*entry.child, box, key, orphans)) continue;
+
+        if (entry.child->entries.size() < minEntries) {
+            collectItems(*entry.child, orphans);
+            node.entries.erase(node.entries.begin() + i);
+        } else {
+            entry.box = nodeBox(*entry.child);
+        }
+        return true;
+    }
+    return false;
+}
+
+template <typename Key>
+void RTree<Key>::collectItems(Node& node, std::vector<Item>& items) {
+    for (Entry& entry : node.entries) {
+        if (node.leaf) {
+            items.push_back({entry.box, std::move(entry.key)});
+        } else {
+            collectItems(*entry.child, items);
+        }
+    }
+}
+
+template <typename Key>
+void RTree<Key>::clear() {
+    root.reset();
+    count = 0;
+}
+
+template <typename Key>
+int RTree<Key>::height() const {
+    int levels = 0;
+    for (const Node* node = root.get(); node; node = node->leaf ? nullptr : node->entries.front().child.get()) {
+        ++levels;
+    }
+    return levels;
+}
+
+template <typename Key>
+std::vector<Key> RTree<Key>::query(const BoundingBox& box) const {
+    std::vector<Key> result;
+    query(box, [&result](const Key& key, const BoundingBox&) { result.push_back(key); });
+    return result;
+}
+
+template <typename Key>
+std::vector<Key> RTree<Key>::queryPoint(const Point2D& p) const {
+    return query(BoundingBox{p.first, p.second, p.first, p.second});
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Устойчивый идентификатор элемента SlotMap. После удаления элемента
+// поколение слота увеличивается, и старые дескрипторы становятся недействительными.
+struct Handle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const Handle& other) const {
+        return !(*this == other);
+    }
+};
+
+// Формат "слот:поколение", например 3:1
+inline std::ostream& operator<<(std::ostream& os, const Handle& handle) {
+    return os << handle.index << ':' << handle.generation;
+}
+
+inline std::istream& operator>>(std::istream& is, Handle& handle) {
+    Handle result;
+    char separator = 0;
+    if (is >> result.index >> separator >> result.generation && separator == ':') {
+        handle = result;
+    } else {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+// Контейнер с O(1) вставкой и удалением: элементы лежат плотно в одном
+// векторе, удаление переносит последний элемент на место удаленного,
+// а таблица слотов сопоставляет дескрипторы текущим позициям.
+template <typename T>
+class SlotMap {
+public:
+    Handle insert(T value) {
+        std::uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        slots[slot].position = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(std::move(value));
+        denseSlots.push_back(slot);
+        return {slot, slots[slot].generation};
+    }
+
+    bool erase(const Handle& handle) {
+        if (!contains(handle)) return false;
+
+        std::uint32_t position = slots[handle.index].position;
+        std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+        if (position != last) {
+            dense[position] = std::move(dense[last]);
+            denseSlots[position] = denseSlots[last];
+            slots[denseSlots[position]].position = position;
+        }
+        dense.pop_back();
+        denseSlots.pop_back();
+
+        ++slots[handle.index].generation;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    bool contains(const Handle& handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+               slots[handle.index].position < dense.size() && denseSlots[slots[handle.index].position] == handle.index;
+    }
+
+    T& operator[](const Handle& handle) {
+        if (!contains(handle)) throw std::out_of_range("Invalid handle");
+        return dense[slots[handle.index].position];
+    }
+
+    const T& operator[](const Handle& handle) const {
+        if (!contains(handle)) throw std::out_of_range("Invalid handle");
+        return dense[slots[handle.index].position];
+    }
+
+    // Плотный доступ: позиции 0..size()-1 меняются при удалении
+    T& at(size_t position) { return dense.at(position); }
+    const T& at(size_t position) const { return dense.at(position); }
+
+    Handle handleAt(size_t position) const {
+        std::uint32_t slot = denseSlots.at(position);
+        return {slot, slots[slot].generation};
+    }
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+
+    void reserve(size_t count) {
+        dense.reserve(count);
+        denseSlots.reserve(count);
+        slots.reserve(count);
+    }
+
+    void clear() {
+        for (std::uint32_t slot : denseSlots) {
+            ++slots[slot].generation;
+            freeSlots.push_back(slot);
+        }
+        dense.clear();
+        denseSlots.clear();
+    }
+
+    typename std::vector<T>::iterator begin() { return dense.begin(); }
+    typename std::vector<T>::iterator end() { return dense.end(); }
+    typename std::vector<T>::const_iterator begin() const { return dense.begin(); }
+    typename std::vector<T>::const_iterator end() const { return dense.end(); }
+
+private:
+    struct Slot {
+        std::uint32_t position;
+        std::uint32_t generation;
+    };
+
+    std::vector<T> dense;
+    std::vector<std::uint32_t> denseSlots;  // Слот каждого плотного элемента
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+};
+
+#endif
@@ -1,31 +1,22 @@
 #ifndef TRAPEZOID_H
 #define TRAPEZOID_H
 
-#include "figure.h"
-
-class Trapezoid : public Figure {
-private:
-    std::pair<double, double> vertices[4];
+#include "polygon.h"
 
+class Trapezoid final : public Polygon<Trapezoid, 4> {
 public:
+    static constexpr const char* name = "Trapezoid";
+    static constexpr FigureType type = FigureType::Trapezoid;
+
     Trapezoid();
     Trapezoid(const std::pair<double, double>& v1,
               const std::pair<double, double>& v2,
               const std::pair<double, double>& v3,
               const std::pair<double, double>& v4);
+    Trapezoid(const Trapezoid& other) = default;
 
-    std::pair<double, double> getVertex(int index) const override;
-    void setVertex(int index, const std::pair<double, double>& v) override;
-
-    std::pair<double, double> getCenter() const override;
-    double getArea() const override;
-
-    Figure& operator=(const Figure& other) override;
-    Figure& operator=(Figure&& other) noexcept override;
-    bool operator==(const Figure& other) const override;
-
-    void printVertices(std::ostream& os) const override;
-    void readVertices(std::istream& is) override;
+    using Polygon::operator=;
+    Trapezoid& operator=(const Trapezoid& other) = default;
 };
 
 #endif
\ No newline at end of file
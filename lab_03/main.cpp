@@ -1,23 +1,15 @@
-#include "trapezoid.h"
-#include "rhombus.h"
-#include "pentagon.h"
+#include "figureUtils.h"
+#include "figureLoader.h"
+#include "batch.h"
+#include "overlap.h"
+#include "reportWriter.h"
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <stdexcept>
-
-std::unique_ptr<Figure> createFigure(int type) {
-    switch (type) {
-        case 1:
-            return std::make_unique<Trapezoid>();
-        case 2:
-            return std::make_unique<Rhombus>();
-        case 3:
-            return std::make_unique<Pentagon>();
-        default:
-            throw std::invalid_argument("Unknown figure type");
-    }
-}
+#include <string>
 
 void inputFigure(std::unique_ptr<Figure>& fig) {
     std::cout << "Select figure type:\n";
@@ -29,37 +21,32 @@ void inputFigure(std::unique_ptr<Figure>& fig) {
     std::cin >> choice;
 
     fig = createFigure(choice);
+    switch (choice) {
+        case 1:
+            std::cout << "Enter 4 vertices of trapezoid (x1 y1 x2 y2 x3 y3 x4 y4): ";
+            break;
+        case 2:
+            std::cout << "Enter 4 vertices of rhombus (x1 y1 x2 y2 x3 y3 x4 y4): ";
+            break;
+        default:
+            std::cout << "Enter 5 vertices of pentagon (x1 y1 x2 y2 x3 y3 x4 y4 x5 y5): ";
+    }
     std::cin >> *fig;
 }
 
-void printFigureInfo(const Figure& fig) {
-    std::cout << fig << std::endl;
-    auto center = fig.getCenter();
-    std::cout << "Geometric center: (" << center.first << ", " << center.second << ")" << std::endl;
-    std::cout << "Area: " << static_cast<double>(fig) << std::endl;
-    std::cout << "--------------------------" << std::endl;
-}
-
-double getTotalArea(const std::vector<std::unique_ptr<Figure>>& figures) {
-    double total = 0.0;
-    for (const auto& fig : figures) {
-        if (fig) {
-            total += static_cast<double>(*fig);
+int main(int argc, char* argv[]) {
+    if (isBatchMode(argc, argv)) {
+        try {
+            runBatch(parseBatchArgs(argc, argv), std::cout);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            std::cerr << "Usage: " << argv[0] << " --batch --count N [--remove K] [--seed S]" << std::endl;
+            return 1;
         }
+        return 0;
     }
-    return total;
-}
-
-void removeFigure(std::vector<std::unique_ptr<Figure>>& figures, int index) {
-    if (index < 0 || index >= static_cast<int>(figures.size())) {
-        throw std::out_of_range("Index out of range");
-    }
-    figures.erase(figures.begin() + index);
-    std::cout << "Figure at index " << index << " has been removed." << std::endl;
-}
 
-int main() {
-    std::vector<std::unique_ptr<Figure>> figures;
+    FigureCollection figures;
 
     char choice;
     do {
@@ -67,8 +54,11 @@ int main() {
         std::cout << "1. Add a new figure\n";
         std::cout << "2. Print all figures info\n";
         std::cout << "3. Calculate total area\n";
-        std::cout << "4. Remove a figure by index\n";
+        std::cout << "4. Remove a figure by ID\n";
         std::cout << "5. Exit\n";
+        std::cout << "6. Load figures from file\n";
+        std::cout << "7. Export report to file\n";
+        std::cout << "8. Calculate area covered (overlaps counted once)\n";
         std::cout << "Enter your choice: ";
         std::cin >> choice;
 
@@ -77,7 +67,7 @@ int main() {
                 std::unique_ptr<Figure> newFig;
                 try {
                     inputFigure(newFig);
-                    figures.push_back(std::move(newFig));
+                    figures.add(std::move(newFig));
                     std::cout << "Figure added successfully!" << std::endl;
                 } catch (const std::exception& e) {
                     std::cerr << "Error: " << e.what() << std::endl;
@@ -89,10 +79,8 @@ int main() {
                     std::cout << "No figures to display." << std::endl;
                 } else {
                     std::cout << "\n=== All Figures ===\n";
-                    for (size_t i = 0; i < figures.size(); ++i) {
-                        std::cout << "Figure #" << i + 1 << ": ";
-                        printFigureInfo(*figures[i]);
-                    }
+                    ReportWriter writer(std::cout);
+                    writer.write(figures);
                 }
                 break;
             }
@@ -105,11 +93,16 @@ int main() {
                 if (figures.empty()) {
                     std::cout << "No figures to remove." << std::endl;
                 } else {
-                    int index;
-                    std::cout << "Enter index of figure to remove (0-based): ";
-                    std::cin >> index;
+                    FigureHandle handle;
+                    std::cout << "Enter ID of figure to remove (as printed, e.g. 0:0): ";
+                    if (!(std::cin >> handle)) {
+                        std::cin.clear();
+                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                        std::cerr << "Error: Invalid figure ID" << std::endl;
+                        break;
+                    }
                     try {
-                        removeFigure(figures, index);
+                        removeFigure(figures, handle);
                     } catch (const std::exception& e) {
                         std::cerr << "Error: " << e.what() << std::endl;
                     }
@@ -119,6 +112,43 @@ int main() {
             case '5':
                 std::cout << "Exiting program." << std::endl;
                 break;
+            case '6': {
+                std::string path;
+                std::cout << "Enter file path: ";
+                std::cin >> path;
+                try {
+                    size_t loaded = loadFigures(path, figures);
+                    std::cout << loaded << " figures loaded." << std::endl;
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+                break;
+            }
+            case '7': {
+                std::string path;
+                std::string format;
+                std::cout << "Enter file path: ";
+                std::cin >> path;
+                std::cout << "Enter format (human, csv, jsonl): ";
+                std::cin >> format;
+                try {
+                    std::ofstream file(path);
+                    if (!file) throw std::runtime_error("Cannot open file: " + path);
+                    ReportWriter writer(file, parseReportFormat(format));
+                    writer.write(figures);
+                    writer.flush();
+                    if (!file) throw std::runtime_error("Cannot write file: " + path);
+                    std::cout << figures.size() << " figures exported." << std::endl;
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+                break;
+            }
+            case '8': {
+                // Не O(1), как пункт 3: пересечения ищутся по R-дереву и обрезаются
+                std::cout << "Area covered (overlaps counted once): " << getUnionArea(figures) << std::endl;
+                break;
+            }
             default:
                 std::cout << "Invalid choice. Please try again." << std::endl;
         }
@@ -0,0 +1,29 @@
+#include "affineTransform.h"
+#include <cmath>
+
+AffineTransform AffineTransform::translation(double dx, double dy) {
+    return {1.0, 0.0, 0.0, 1.0, dx, dy};
+}
+
+AffineTransform AffineTransform::rotation(double angle) {
+    double cosA = std::cos(angle);
+    double sinA = std::sin(angle);
+    return {cosA, -sinA, sinA, cosA, 0.0, 0.0};
+}
+
+AffineTransform AffineTransform::scaling(double sx, double sy) {
+    return {sx, 0.0, 0.0, sy, 0.0, 0.0};
+}
+
+double AffineTransform::determinant() const {
+    return a * d - b * c;
+}
+
+AffineTransform AffineTransform::operator*(const AffineTransform& other) const {
+    return {a * other.a + b * other.c,
+            a * other.b + b * other.d,
+            c * other.a + d * other.c,
+            c * other.b + d * other.d,
+            a * other.tx + b * other.ty + tx,
+            c * other.tx + d * other.ty + ty};
+}
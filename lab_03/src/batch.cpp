@@ -0,0 +1,191 @@
+#include "batch.h"
+#include "figureCollection.h"
+#include "figureUtils.h"
+#include "figurePool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+size_t parseCount(const char* value, const char* name) {
+    try {
+        size_t pos = 0;
+        unsigned long long result = std::stoull(value, &pos);
+        if (pos != std::strlen(value) || value[0] == '-') throw std::invalid_argument(name);
+        return static_cast<size_t>(result);
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument(std::string("Invalid value for ") + name + ": " + value);
+    }
+}
+
+void printPhase(std::ostream& os, const char* name, Clock::duration elapsed, size_t items) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    os << std::left << std::setw(12) << name << std::right
+       << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0
+       << std::setw(16) << std::setprecision(0) << (seconds > 0 ? items / seconds : 0.0) << "\n";
+}
+
+}
+
+bool isBatchMode(int argc, char* argv[]) {
+    return argc > 1 && std::strcmp(argv[1], "--batch") == 0;
+}
+
+BatchConfig parseBatchArgs(int argc, char* argv[]) {
+    BatchConfig config;
+    for (int i = 2; i < argc; ++i) {
+        if (i + 1 >= argc) throw std::invalid_argument(std::string("Missing value for ") + argv[i]);
+
+        if (std::strcmp(argv[i], "--count") == 0) {
+            config.figuresPerType = parseCount(argv[++i], "--count");
+        } else if (std::strcmp(argv[i], "--remove") == 0) {
+            config.removeCount = parseCount(argv[++i], "--remove");
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            config.seed = static_cast<unsigned>(parseCount(argv[++i], "--seed"));
+        } else {
+            throw std::invalid_argument(std::string("Unknown option: ") + argv[i]);
+        }
+    }
+
+    if (config.removeCount > config.figuresPerType * 3) {
+        throw std::invalid_argument("Cannot remove more figures than generated");
+    }
+    return config;
+}
+
+std::unique_ptr<Figure> randomFigure(int type, std::mt19937& rng, double extent) {
+    std::uniform_real_distribution<double> position(0.0, extent * 0.99);
+    std::uniform_real_distribution<double> size(extent * 0.001, extent * 0.01);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double pi = std::acos(-1.0);
+
+    double x = position(rng);
+    double y = position(rng);
+    std::pair<double, double> v[5];
+
+    switch (type) {
+        case 1: {
+            double bottom = size(rng);
+            double top = bottom * (0.2 + 0.6 * unit(rng));
+            double offset = (bottom - top) * unit(rng);
+            double height = size(rng);
+            v[0] = {x, y};
+            v[1] = {x + bottom, y};
+            v[2] = {x + offset + top, y + height};
+            v[3] = {x + offset, y + height};
+            break;
+        }
+        case 2: {
+            double side = size(rng) / 2.0;
+            double angle = pi * (0.1 + 0.4 * unit(rng));
+            double dx = side * std::cos(angle);
+            double dy = side * std::sin(angle);
+            v[0] = {x, y};
+            v[1] = {x + side, y};
+            v[2] = {x + side + dx, y + dy};
+            v[3] = {x + dx, y + dy};
+            break;
+        }
+        case 3: {
+            double radius = size(rng) / 2.0;
+            for (int k = 0; k < 5; ++k) {
+                double angle = 2.0 * pi * k / 5.0;
+                double r = radius * (0.8 + 0.2 * unit(rng));
+                v[k] = {x + radius + r * std::cos(angle), y + radius + r * std::sin(angle)};
+            }
+            break;
+        }
+        default:
+            throw std::invalid_argument("Unknown figure type");
+    }
+
+    return createFigure(type, v);
+}
+
+void runBatch(const BatchConfig& config, std::ostream& os) {
+    std::mt19937 rng(config.seed);
+    FigureCollection figures;
+    size_t total = config.figuresPerType * 3;
+
+    os << "=== Batch run ===\n";
+#ifndef __OPTIMIZE__
+    os << "Warning: built without optimizations, timings are not representative "
+          "(configure with -DCMAKE_BUILD_TYPE=Release)\n";
+#endif
+    os << "Figures: " << total << " (" << config.figuresPerType << " per type), remove: "
+       << config.removeCount << ", seed: " << config.seed << "\n\n";
+    os << std::left << std::setw(12) << "phase" << std::right
+       << std::setw(12) << "time, ms" << std::setw(16) << "figures/s" << "\n";
+
+    auto start = Clock::now();
+    std::vector<std::unique_ptr<Figure>> generated;
+    generated.reserve(total);
+    for (int type = 1; type <= 3; ++type) {
+        for (size_t i = 0; i < config.figuresPerType; ++i) {
+            generated.push_back(randomFigure(type, rng));
+        }
+    }
+    printPhase(os, "generate", Clock::now() - start, total);
+
+    // Площади новых фигур еще не закэшированы: замеряется сам расчет.
+    // add() ниже берет уже готовые значения из кэша
+    start = Clock::now();
+    double sum = 0.0;
+    double minArea = std::numeric_limits<double>::infinity();
+    double maxArea = 0.0;
+    for (const auto& fig : generated) {
+        double area = static_cast<double>(*fig);
+        sum += area;
+        minArea = std::min(minArea, area);
+        maxArea = std::max(maxArea, area);
+    }
+    printPhase(os, "area", Clock::now() - start, total);
+
+    start = Clock::now();
+    for (auto& fig : generated) {
+        figures.add(std::move(fig));
+    }
+    generated.clear();
+    printPhase(os, "insert", Clock::now() - start, total);
+
+    // Поворот всей сцены вокруг ее центра
+    start = Clock::now();
+    figures.transform(AffineTransform::translation(500.0, 500.0) * AffineTransform::rotation(0.5) *
+                      AffineTransform::translation(-500.0, -500.0));
+    printPhase(os, "transform", Clock::now() - start, figures.size());
+
+    start = Clock::now();
+    for (size_t i = 0; i < config.removeCount; ++i) {
+        std::uniform_int_distribution<size_t> position(0, figures.size() - 1);
+        figures.remove(figures.handleAt(position(rng)));
+    }
+    printPhase(os, "remove", Clock::now() - start, config.removeCount);
+
+    size_t left = figures.size();
+    double areaLeft = figures.getTotalArea();
+    size_t poolPages = FigurePool::pageCount();
+
+    start = Clock::now();
+    figures.clear();
+    FigurePool::release();
+    printPhase(os, "teardown", Clock::now() - start, left);
+
+    os << "\nTotal area: " << std::setprecision(6) << std::defaultfloat << sum << "\n";
+    if (total > 0) {
+        os << "Mean area: " << sum / total << "\n";
+        os << "Min area: " << minArea << "\n";
+        os << "Max area: " << maxArea << "\n";
+    }
+    os << "Figures left: " << left << "\n";
+    os << "Area left: " << areaLeft << "\n";
+    os << "Pool pages: " << poolPages << "\n";
+}
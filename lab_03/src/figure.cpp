@@ -1,4 +1,52 @@
 #include "figure.h"
+#include "figurePool.h"
+#include <cmath>
+
+void* Figure::operator new(std::size_t size) {
+    return FigurePool::allocate(size);
+}
+
+void Figure::operator delete(void* p, std::size_t size) noexcept {
+    FigurePool::deallocate(p, size);
+}
+
+std::pair<double, double> Figure::getCenter() const {
+    if (!cacheValid) updateCache();
+    return cachedCenter;
+}
+
+double Figure::getArea() const {
+    if (!cacheValid) updateCache();
+    return cachedArea;
+}
+
+std::size_t Figure::hash() const {
+    if (!hashValid) {
+        cachedHash = computeHash();
+        hashValid = true;
+    }
+    return cachedHash;
+}
+
+void Figure::transform(const AffineTransform& m) {
+    transformVertices(m);
+    hashValid = false;
+    if (cacheValid) {
+        cachedArea *= std::abs(m.determinant());
+        cachedCenter = m.apply(cachedCenter);
+    }
+}
+
+void Figure::invalidateCache() noexcept {
+    cacheValid = false;
+    hashValid = false;
+}
+
+void Figure::updateCache() const {
+    cachedArea = computeArea();
+    cachedCenter = computeCenter();
+    cacheValid = true;
+}
 
 std::ostream& operator<<(std::ostream& os, const Figure& fig) {
     fig.printVertices(os);
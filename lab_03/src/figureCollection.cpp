@@ -0,0 +1,127 @@
+#include "figureCollection.h"
+#include <cmath>
+#include <stdexcept>
+
+FigureHandle FigureCollection::add(std::unique_ptr<Figure> fig) {
+    if (!fig) throw std::invalid_argument("Null figure");
+    accumulate(fig->getArea());
+    if (spatialIndex) spatialIndex->insert(getBoundingBox(*fig), fig.get());
+    return figures.insert(std::move(fig));
+}
+
+void FigureCollection::remove(const FigureHandle& handle) {
+    if (!figures.contains(handle)) throw std::out_of_range("Invalid figure handle");
+    const Figure& fig = *figures[handle];
+    accumulate(-fig.getArea());
+    if (spatialIndex) spatialIndex->remove(getBoundingBox(fig), &fig);
+    figures.erase(handle);
+
+    if (figures.empty()) {
+        totalArea = 0.0;
+        compensation = 0.0;
+    }
+}
+
+void FigureCollection::clear() {
+    figures.clear();
+    spatialIndex.reset();
+    totalArea = 0.0;
+    compensation = 0.0;
+}
+
+bool FigureCollection::contains(const FigureHandle& handle) const {
+    return figures.contains(handle);
+}
+
+const Figure& FigureCollection::operator[](const FigureHandle& handle) const {
+    return *figures[handle];
+}
+
+const Figure& FigureCollection::operator[](size_t position) const {
+    if (position >= figures.size()) throw std::out_of_range("Index out of range");
+    return *figures.at(position);
+}
+
+FigureHandle FigureCollection::handleAt(size_t position) const {
+    if (position >= figures.size()) throw std::out_of_range("Index out of range");
+    return figures.handleAt(position);
+}
+
+size_t FigureCollection::size() const {
+    return figures.size();
+}
+
+bool FigureCollection::empty() const {
+    return figures.empty();
+}
+
+void FigureCollection::transform(const AffineTransform& m) {
+    for (auto& fig : figures) {
+        fig->transform(m);
+    }
+
+    double scale = std::abs(m.determinant());
+    totalArea *= scale;
+    compensation *= scale;
+    spatialIndex.reset();
+}
+
+void FigureCollection::transform(const std::vector<FigureHandle>& handles, const AffineTransform& m) {
+    for (const FigureHandle& handle : handles) {
+        if (!figures.contains(handle)) throw std::out_of_range("Invalid figure handle");
+    }
+
+    for (const FigureHandle& handle : handles) {
+        Figure& fig = *figures[handle];
+        double oldArea = fig.getArea();
+        BoundingBox oldBox = spatialIndex ? getBoundingBox(fig) : BoundingBox{};
+
+        fig.transform(m);
+        accumulate(fig.getArea() - oldArea);
+        if (spatialIndex) {
+            spatialIndex->remove(oldBox, &fig);
+            spatialIndex->insert(getBoundingBox(fig), &fig);
+        }
+    }
+}
+
+double FigureCollection::getTotalArea() const {
+    return totalArea;
+}
+
+std::vector<const Figure*> FigureCollection::queryWindow(const BoundingBox& box) const {
+    std::vector<const Figure*> result;
+    index().query(box, [&result, &box](const Figure* fig, const BoundingBox&) {
+        if (figureIntersectsBox(*fig, box)) result.push_back(fig);
+    });
+    return result;
+}
+
+std::vector<const Figure*> FigureCollection::queryPoint(const Point2D& p) const {
+    std::vector<const Figure*> result;
+    index().query(BoundingBox{p.first, p.second, p.first, p.second},
+                  [&result, &p](const Figure* fig, const BoundingBox&) {
+        if (figureContains(*fig, p)) result.push_back(fig);
+    });
+    return result;
+}
+
+const RTree<const Figure*>& FigureCollection::index() const {
+    if (!spatialIndex) {
+        std::vector<RTree<const Figure*>::Item> items;
+        items.reserve(figures.size());
+        for (const auto& fig : figures) {
+            items.push_back({getBoundingBox(*fig), fig.get()});
+        }
+        spatialIndex = std::make_unique<RTree<const Figure*>>();
+        spatialIndex->bulkLoad(std::move(items));
+    }
+    return *spatialIndex;
+}
+
+void FigureCollection::accumulate(double value) {
+    double y = value - compensation;
+    double t = totalArea + y;
+    compensation = (t - totalArea) - y;
+    totalArea = t;
+}
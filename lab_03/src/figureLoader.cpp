@@ -0,0 +1,270 @@
+#include "figureLoader.h"
+#include "figureUtils.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char magic[4] = {'F', 'I', 'G', '3'};
+const std::uint32_t formatVersion = 1;
+
+// Текст читается блоками такого размера, а не построчно
+const size_t chunkSize = 1 << 20;
+
+bool isKind(long value) {
+    return value >= 1 && value <= 3;
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+template <typename Sink>
+void parseLine(const char* p, const char* end, size_t lineNumber, Sink& sink) {
+    p = skipSpaces(p, end);
+    if (p == end || *p == '#') return;
+
+    int type = 0;
+    auto parsed = std::from_chars(p, end, type);
+    if (parsed.ec != std::errc() || !isKind(type)) {
+        throw std::runtime_error("Invalid figure type at line " + std::to_string(lineNumber));
+    }
+    p = parsed.ptr;
+
+    FigureStore::Kind kind = static_cast<FigureStore::Kind>(type);
+    std::pair<double, double> vertices[5];
+    for (size_t k = 0; k < FigureStore::vertexCount(kind); ++k) {
+        double* coords[2] = {&vertices[k].first, &vertices[k].second};
+        for (double* coord : coords) {
+            p = skipSpaces(p, end);
+            parsed = std::from_chars(p, end, *coord);
+            if (parsed.ec != std::errc()) {
+                throw std::runtime_error("Invalid coordinate at line " + std::to_string(lineNumber));
+            }
+            p = parsed.ptr;
+        }
+    }
+
+    if (skipSpaces(p, end) != end) {
+        throw std::runtime_error("Unexpected data at line " + std::to_string(lineNumber));
+    }
+    sink(kind, vertices);
+}
+
+template <typename Sink>
+size_t parseText(std::istream& is, Sink sink) {
+    std::vector<char> buffer(chunkSize);
+    size_t filled = 0;
+    size_t lineNumber = 0;
+    size_t loaded = 0;
+    auto counted = [&sink, &loaded](FigureStore::Kind kind, const std::pair<double, double>* v) {
+        sink(kind, v);
+        ++loaded;
+    };
+
+    while (true) {
+        if (filled == buffer.size()) buffer.resize(buffer.size() * 2);
+        is.read(buffer.data() + filled, buffer.size() - filled);
+        size_t read = static_cast<size_t>(is.gcount());
+        filled += read;
+        bool last = read == 0;
+
+        const char* begin = buffer.data();
+        const char* end = buffer.data() + filled;
+        const char* line = begin;
+        while (true) {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            if (!newline) break;
+            parseLine(line, newline, ++lineNumber, counted);
+            line = newline + 1;
+        }
+
+        if (last) {
+            if (line != end) parseLine(line, end, ++lineNumber, counted);
+            return loaded;
+        }
+
+        filled = end - line;
+        std::memmove(buffer.data(), line, filled);
+    }
+}
+
+template <typename Sink>
+size_t parseBinary(const std::string& path, Sink sink) {
+    MappedFigureFile file(path);
+    std::pair<double, double> vertices[5];
+    for (const FigureRecord& record : file) {
+        if (!isKind(record.kind)) throw std::runtime_error("Invalid figure type in file: " + path);
+        FigureStore::Kind kind = static_cast<FigureStore::Kind>(record.kind);
+        for (size_t k = 0; k < FigureStore::vertexCount(kind); ++k) {
+            vertices[k] = {record.coords[2 * k], record.coords[2 * k + 1]};
+        }
+        sink(kind, vertices);
+    }
+    return file.size();
+}
+
+bool isBinaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file: " + path);
+    char header[4] = {};
+    file.read(header, sizeof(header));
+    return file.gcount() == sizeof(header) && std::memcmp(header, magic, sizeof(magic)) == 0;
+}
+
+auto storeSink(FigureStore& store) {
+    return [&store](FigureStore::Kind kind, const std::pair<double, double>* v) {
+        store.add(kind, v);
+    };
+}
+
+auto collectionSink(FigureCollection& figures) {
+    return [&figures](FigureStore::Kind kind, const std::pair<double, double>* v) {
+        figures.add(createFigure(static_cast<int>(kind), v));
+    };
+}
+
+}
+
+MappedFigureFile::MappedFigureFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file: " + path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FigureFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid figure file: " + path);
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+
+    const FigureFileHeader* header = static_cast<const FigureFileHeader*>(mapping);
+    count = header->count;
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != formatVersion ||
+        count > (length - sizeof(FigureFileHeader)) / sizeof(FigureRecord)) {
+        ::munmap(mapping, length);
+        mapping = nullptr;
+        throw std::runtime_error("Invalid figure file: " + path);
+    }
+
+    records = reinterpret_cast<const FigureRecord*>(static_cast<const char*>(mapping) + sizeof(FigureFileHeader));
+    ::madvise(mapping, length, MADV_SEQUENTIAL);
+}
+
+MappedFigureFile::~MappedFigureFile() {
+    if (mapping) ::munmap(mapping, length);
+}
+
+size_t MappedFigureFile::size() const {
+    return count;
+}
+
+const FigureRecord& MappedFigureFile::operator[](size_t index) const {
+    if (index >= count) throw std::out_of_range("Index out of range");
+    return records[index];
+}
+
+const FigureRecord* MappedFigureFile::begin() const {
+    return records;
+}
+
+const FigureRecord* MappedFigureFile::end() const {
+    return records + count;
+}
+
+size_t loadText(std::istream& is, FigureStore& store) {
+    return parseText(is, storeSink(store));
+}
+
+size_t loadText(std::istream& is, FigureCollection& figures) {
+    return parseText(is, collectionSink(figures));
+}
+
+size_t loadBinary(const std::string& path, FigureStore& store) {
+    return parseBinary(path, storeSink(store));
+}
+
+size_t loadBinary(const std::string& path, FigureCollection& figures) {
+    return parseBinary(path, collectionSink(figures));
+}
+
+size_t loadFigures(const std::string& path, FigureStore& store) {
+    if (isBinaryFile(path)) return loadBinary(path, store);
+    std::ifstream file(path, std::ios::binary);
+    return loadText(file, store);
+}
+
+size_t loadFigures(const std::string& path, FigureCollection& figures) {
+    if (isBinaryFile(path)) return loadBinary(path, figures);
+    std::ifstream file(path, std::ios::binary);
+    return loadText(file, figures);
+}
+
+void saveText(std::ostream& os, const FigureStore& store) {
+    std::vector<char> buffer;
+    buffer.reserve(chunkSize + 512);
+    char number[32];
+
+    for (size_t i = 0; i < store.size(); ++i) {
+        FigureStore::Kind kind = store.getKind(i);
+        buffer.push_back(static_cast<char>('0' + static_cast<int>(kind)));
+        for (size_t k = 0; k < FigureStore::vertexCount(kind); ++k) {
+            auto v = store.getVertex(i, static_cast<int>(k));
+            for (double coord : {v.first, v.second}) {
+                buffer.push_back(' ');
+                char* end = std::to_chars(number, number + sizeof(number), coord).ptr;
+                buffer.insert(buffer.end(), number, end);
+            }
+        }
+        buffer.push_back('\n');
+
+        if (buffer.size() >= chunkSize) {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
+void saveBinary(const std::string& path, const FigureStore& store) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file: " + path);
+
+    FigureFileHeader header = {{magic[0], magic[1], magic[2], magic[3]}, formatVersion, store.size()};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<FigureRecord> records;
+    records.reserve(chunkSize / sizeof(FigureRecord));
+    for (size_t i = 0; i < store.size(); ++i) {
+        FigureRecord record = {};
+        record.kind = static_cast<std::uint32_t>(store.getKind(i));
+        for (size_t k = 0; k < FigureStore::vertexCount(store.getKind(i)); ++k) {
+            auto v = store.getVertex(i, static_cast<int>(k));
+            record.coords[2 * k] = v.first;
+            record.coords[2 * k + 1] = v.second;
+        }
+        records.push_back(record);
+
+        if (records.size() == records.capacity()) {
+            file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FigureRecord));
+            records.clear();
+        }
+    }
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FigureRecord));
+
+    if (!file) throw std::runtime_error("Cannot write file: " + path);
+}
@@ -0,0 +1,128 @@
+#include "figurePool.h"
+#include <mutex>
+#include <new>
+
+namespace {
+
+const size_t granularity = 16;
+const size_t classCount = 16;  // Блоки до 256 байт, крупнее - обычная куча
+
+// Заголовок страницы занимает granularity байт, чтобы блоки оставались выровненными
+const size_t headerSize = granularity;
+
+// Свой мьютекс у каждого класса размеров: фигуры разных типов создаются
+// параллельно без общей блокировки
+struct SizeClass {
+    FixedPool pool;
+    std::mutex mutex;
+};
+
+// Инициализация константная, а деструкторы тривиальны, поэтому фигуры в
+// статических объектах можно безопасно удалять и после завершения main
+SizeClass classes[classCount] = {
+    {FixedPool(1 * granularity)},  {FixedPool(2 * granularity)},  {FixedPool(3 * granularity)},
+    {FixedPool(4 * granularity)},  {FixedPool(5 * granularity)},  {FixedPool(6 * granularity)},
+    {FixedPool(7 * granularity)},  {FixedPool(8 * granularity)},  {FixedPool(9 * granularity)},
+    {FixedPool(10 * granularity)}, {FixedPool(11 * granularity)}, {FixedPool(12 * granularity)},
+    {FixedPool(13 * granularity)}, {FixedPool(14 * granularity)}, {FixedPool(15 * granularity)},
+    {FixedPool(16 * granularity)}};
+
+size_t classIndex(size_t size) {
+    return (size + granularity - 1) / granularity - 1;
+}
+
+}
+
+void* FixedPool::allocate() {
+    if (freeList) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        ++live;
+        return block;
+    }
+
+    if (cursor == pageEnd) {
+        char* memory = static_cast<char*>(::operator new(pageSize));
+        Page* page = reinterpret_cast<Page*>(memory);
+        page->next = pageList;
+        pageList = page;
+        ++pages;
+
+        cursor = memory + headerSize;
+        pageEnd = cursor + (pageSize - headerSize) / blockSize * blockSize;
+    }
+
+    void* block = cursor;
+    cursor += blockSize;
+    ++live;
+    return block;
+}
+
+void FixedPool::deallocate(void* p) noexcept {
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = freeList;
+    freeList = block;
+    --live;
+}
+
+bool FixedPool::release() noexcept {
+    if (live != 0) return false;
+
+    while (pageList) {
+        Page* next = pageList->next;
+        ::operator delete(pageList);
+        pageList = next;
+    }
+    freeList = nullptr;
+    cursor = nullptr;
+    pageEnd = nullptr;
+    pages = 0;
+    return true;
+}
+
+namespace FigurePool {
+
+void* allocate(size_t size) {
+    if (size == 0 || size > classCount * granularity) return ::operator new(size);
+    SizeClass& sizeClass = classes[classIndex(size)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    return sizeClass.pool.allocate();
+}
+
+void deallocate(void* p, size_t size) noexcept {
+    if (!p) return;
+    if (size == 0 || size > classCount * granularity) {
+        ::operator delete(p);
+        return;
+    }
+    SizeClass& sizeClass = classes[classIndex(size)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.pool.deallocate(p);
+}
+
+size_t liveCount() {
+    size_t total = 0;
+    for (SizeClass& sizeClass : classes) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        total += sizeClass.pool.liveCount();
+    }
+    return total;
+}
+
+size_t pageCount() {
+    size_t total = 0;
+    for (SizeClass& sizeClass : classes) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        total += sizeClass.pool.pageCount();
+    }
+    return total;
+}
+
+void release() noexcept {
+    for (SizeClass& sizeClass : classes) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        sizeClass.pool.release();
+    }
+}
+
+}
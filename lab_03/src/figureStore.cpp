@@ -0,0 +1,224 @@
+#include "figureStore.h"
+#include "figureUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Размер блока, для которого промежуточные суммы остаются в L1
+const size_t blockSize = 256;
+
+// Удвоенная ориентированная площадь фигур [begin, begin + count) группы.
+// Внутренний цикл идет по фигурам, поэтому компилятор векторизует его.
+template <size_t N>
+void shoelaceBlock(const std::vector<std::vector<double>>& xs,
+                   const std::vector<std::vector<double>>& ys,
+                   size_t begin, size_t count, double* out) {
+    for (size_t i = 0; i < count; ++i) out[i] = 0;
+
+    for (size_t k = 0; k < N; ++k) {
+        const double* x0 = xs[k].data() + begin;
+        const double* y0 = ys[k].data() + begin;
+        const double* x1 = xs[(k + 1) % N].data() + begin;
+        const double* y1 = ys[(k + 1) % N].data() + begin;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] += x0[i] * y1[i] - x1[i] * y0[i];
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) out[i] = std::abs(out[i]) / 2.0;
+}
+
+void groupAreas(size_t vertexCount,
+                const std::vector<std::vector<double>>& xs,
+                const std::vector<std::vector<double>>& ys,
+                size_t begin, size_t count, double* out) {
+    if (vertexCount == 4) {
+        shoelaceBlock<4>(xs, ys, begin, count, out);
+    } else {
+        shoelaceBlock<5>(xs, ys, begin, count, out);
+    }
+}
+
+}
+
+size_t FigureStore::vertexCount(Kind kind) {
+    return kind == Kind::Pentagon ? 5 : 4;
+}
+
+size_t FigureStore::groupIndex(Kind kind) {
+    return kind == Kind::Pentagon ? 1 : 0;
+}
+
+void FigureStore::add(const Figure& fig) {
+    Kind kind = fig.getType();
+
+    std::pair<double, double> vertices[5];
+    for (size_t k = 0; k < vertexCount(kind); ++k) {
+        vertices[k] = fig.getVertex(static_cast<int>(k));
+    }
+    add(kind, vertices);
+}
+
+void FigureStore::add(Kind kind, const std::pair<double, double>* vertices) {
+    Group& group = groups[groupIndex(kind)];
+    for (size_t k = 0; k < group.vertexCount; ++k) {
+        group.xs[k].push_back(vertices[k].first);
+        group.ys[k].push_back(vertices[k].second);
+    }
+    group.kinds.push_back(kind);
+    group.indices.push_back(locations.size());
+    locations.push_back({groupIndex(kind), group.kinds.size() - 1});
+}
+
+void FigureStore::reserve(Kind kind, size_t count) {
+    Group& group = groups[groupIndex(kind)];
+    for (size_t k = 0; k < group.vertexCount; ++k) {
+        group.xs[k].reserve(count);
+        group.ys[k].reserve(count);
+    }
+    group.kinds.reserve(count);
+    group.indices.reserve(count);
+    locations.reserve(locations.size() + count);
+}
+
+void FigureStore::clear() {
+    for (Group& group : groups) {
+        for (size_t k = 0; k < group.vertexCount; ++k) {
+            group.xs[k].clear();
+            group.ys[k].clear();
+        }
+        group.kinds.clear();
+        group.indices.clear();
+    }
+    locations.clear();
+}
+
+size_t FigureStore::size() const {
+    return locations.size();
+}
+
+FigureStore::Kind FigureStore::getKind(size_t index) const {
+    if (index >= locations.size()) throw std::out_of_range("Index out of range");
+    const Location& location = locations[index];
+    return groups[location.group].kinds[location.offset];
+}
+
+std::pair<double, double> FigureStore::getVertex(size_t index, int vertex) const {
+    if (index >= locations.size()) throw std::out_of_range("Index out of range");
+    const Location& location = locations[index];
+    const Group& group = groups[location.group];
+    if (vertex < 0 || vertex >= static_cast<int>(group.vertexCount)) {
+        throw std::out_of_range("Invalid vertex index");
+    }
+    return {group.xs[vertex][location.offset], group.ys[vertex][location.offset]};
+}
+
+std::unique_ptr<Figure> FigureStore::get(size_t index) const {
+    std::pair<double, double> v[5];
+    Kind kind = getKind(index);
+    for (size_t k = 0; k < vertexCount(kind); ++k) {
+        v[k] = getVertex(index, static_cast<int>(k));
+    }
+    return createFigure(static_cast<int>(kind), v);
+}
+
+void FigureStore::transform(const AffineTransform& m) {
+    // Копии коэффициентов: запись в координаты не может их изменить,
+    // поэтому цикл векторизуется
+    const double a = m.a, b = m.b, c = m.c, d = m.d, tx = m.tx, ty = m.ty;
+
+    for (Group& group : groups) {
+        size_t count = group.kinds.size();
+        for (size_t k = 0; k < group.vertexCount; ++k) {
+            double* x = group.xs[k].data();
+            double* y = group.ys[k].data();
+            for (size_t i = 0; i < count; ++i) {
+                double px = x[i];
+                double py = y[i];
+                x[i] = a * px + b * py + tx;
+                y[i] = c * px + d * py + ty;
+            }
+        }
+    }
+}
+
+void FigureStore::transform(const std::vector<size_t>& indices, const AffineTransform& m) {
+    for (size_t index : indices) {
+        if (index >= locations.size()) throw std::out_of_range("Index out of range");
+    }
+
+    for (size_t index : indices) {
+        const Location& location = locations[index];
+        Group& group = groups[location.group];
+        for (size_t k = 0; k < group.vertexCount; ++k) {
+            std::pair<double, double> p = m.apply({group.xs[k][location.offset], group.ys[k][location.offset]});
+            group.xs[k][location.offset] = p.first;
+            group.ys[k][location.offset] = p.second;
+        }
+    }
+}
+
+double FigureStore::getTotalArea() const {
+    double total = 0.0;
+    double areas[blockSize];
+
+    for (const Group& group : groups) {
+        size_t count = group.kinds.size();
+        for (size_t begin = 0; begin < count; begin += blockSize) {
+            size_t length = std::min(blockSize, count - begin);
+            groupAreas(group.vertexCount, group.xs, group.ys, begin, length, areas);
+            for (size_t i = 0; i < length; ++i) total += areas[i];
+        }
+    }
+
+    return total;
+}
+
+std::vector<double> FigureStore::getAreas() const {
+    std::vector<double> result(locations.size());
+    double areas[blockSize];
+
+    for (const Group& group : groups) {
+        size_t count = group.kinds.size();
+        for (size_t begin = 0; begin < count; begin += blockSize) {
+            size_t length = std::min(blockSize, count - begin);
+            groupAreas(group.vertexCount, group.xs, group.ys, begin, length, areas);
+            for (size_t i = 0; i < length; ++i) result[group.indices[begin + i]] = areas[i];
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::pair<double, double>> FigureStore::getCenters() const {
+    std::vector<std::pair<double, double>> result(locations.size());
+    double cx[blockSize];
+    double cy[blockSize];
+
+    for (const Group& group : groups) {
+        size_t count = group.kinds.size();
+        double n = static_cast<double>(group.vertexCount);
+        for (size_t begin = 0; begin < count; begin += blockSize) {
+            size_t length = std::min(blockSize, count - begin);
+            for (size_t i = 0; i < length; ++i) {
+                cx[i] = 0;
+                cy[i] = 0;
+            }
+            for (size_t k = 0; k < group.vertexCount; ++k) {
+                const double* x = group.xs[k].data() + begin;
+                const double* y = group.ys[k].data() + begin;
+                for (size_t i = 0; i < length; ++i) {
+                    cx[i] += x[i];
+                    cy[i] += y[i];
+                }
+            }
+            for (size_t i = 0; i < length; ++i) {
+                result[group.indices[begin + i]] = {cx[i] / n, cy[i] / n};
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,92 @@
+#include "figureUtils.h"
+#include "reportWriter.h"
+#include "parallelSum.h"
+#include <stdexcept>
+#include <unordered_set>
+
+std::unique_ptr<Figure> createFigure(int type) {
+    switch (type) {
+        case 1:
+            return std::make_unique<Trapezoid>();
+        case 2:
+            return std::make_unique<Rhombus>();
+        case 3:
+            return std::make_unique<Pentagon>();
+        default:
+            throw std::invalid_argument("Unknown figure type");
+    }
+}
+
+std::unique_ptr<Figure> createFigure(int type, const std::pair<double, double>* v) {
+    switch (type) {
+        case 1:
+            return std::make_unique<Trapezoid>(v[0], v[1], v[2], v[3]);
+        case 2:
+            return std::make_unique<Rhombus>(v[0], v[1], v[2], v[3]);
+        case 3:
+            return std::make_unique<Pentagon>(v[0], v[1], v[2], v[3], v[4]);
+        default:
+            throw std::invalid_argument("Unknown figure type");
+    }
+}
+
+void printFigureInfo(const Figure& fig) {
+    ReportWriter writer(std::cout);
+    writer.write(fig);
+}
+
+void printFigureInfo(const FigureVariant& fig) {
+    ReportWriter writer(std::cout);
+    std::visit([&writer](const Figure& figure) { writer.write(figure); }, fig);
+}
+
+double getTotalArea(const std::vector<std::unique_ptr<Figure>>& figures, unsigned threads) {
+    return parallelSum(figures.size(), [&figures](size_t i) {
+        return figures[i] ? static_cast<double>(*figures[i]) : 0.0;
+    }, threads);
+}
+
+double getTotalArea(const std::vector<FigureVariant>& figures, unsigned threads) {
+    return parallelSum(figures.size(), [&figures](size_t i) { return getArea(figures[i]); }, threads);
+}
+
+double getTotalArea(const FigureCollection& figures) {
+    return figures.getTotalArea();
+}
+
+void removeFigure(std::vector<std::unique_ptr<Figure>>& figures, int index) {
+    if (index < 0 || index >= static_cast<int>(figures.size())) {
+        throw std::out_of_range("Index out of range");
+    }
+    figures.erase(figures.begin() + index);
+    std::cout << "Figure at index " << index << " has been removed." << std::endl;
+}
+
+void removeFigure(FigureCollection& figures, const FigureHandle& handle) {
+    figures.remove(handle);
+    std::cout << "Figure " << handle << " has been removed." << std::endl;
+}
+
+size_t removeDuplicates(std::vector<std::unique_ptr<Figure>>& figures) {
+    std::unordered_set<const Figure*, FigureHash, FigureEqual> seen(figures.size());
+    size_t kept = 0;
+    for (auto& fig : figures) {
+        if (fig && !seen.insert(fig.get()).second) continue;
+        figures[kept++] = std::move(fig);
+    }
+    size_t removed = figures.size() - kept;
+    figures.resize(kept);
+    return removed;
+}
+
+size_t removeDuplicates(FigureCollection& figures) {
+    std::unordered_set<const Figure*, FigureHash, FigureEqual> seen(figures.size());
+    std::vector<FigureHandle> duplicates;
+    for (size_t i = 0; i < figures.size(); ++i) {
+        if (!seen.insert(&figures[i]).second) duplicates.push_back(figures.handleAt(i));
+    }
+    for (const FigureHandle& handle : duplicates) {
+        figures.remove(handle);
+    }
+    return duplicates.size();
+}
@@ -0,0 +1,37 @@
+#include "figureVariant.h"
+#include <stdexcept>
+
+double getArea(const FigureVariant& fig) {
+    return std::visit([](const auto& f) { return f.getArea(); }, fig);
+}
+
+std::pair<double, double> getCenter(const FigureVariant& fig) {
+    return std::visit([](const auto& f) { return f.getCenter(); }, fig);
+}
+
+std::pair<double, double> getVertex(const FigureVariant& fig, int index) {
+    return std::visit([index](const auto& f) { return f.getVertex(index); }, fig);
+}
+
+FigureVariant toVariant(const Figure& fig) {
+    switch (fig.getType()) {
+        case FigureType::Trapezoid:
+            return static_cast<const Trapezoid&>(fig);
+        case FigureType::Rhombus:
+            return static_cast<const Rhombus&>(fig);
+        case FigureType::Pentagon:
+            return static_cast<const Pentagon&>(fig);
+    }
+    throw std::invalid_argument("Unknown figure type");
+}
+
+std::unique_ptr<Figure> toFigure(const FigureVariant& fig) {
+    return std::visit([](const auto& f) -> std::unique_ptr<Figure> {
+        return std::make_unique<std::decay_t<decltype(f)>>(f);
+    }, fig);
+}
+
+std::ostream& operator<<(std::ostream& os, const FigureVariant& fig) {
+    std::visit([&os](const auto& f) { f.printVertices(os); }, fig);
+    return os;
+}
@@ -0,0 +1,138 @@
+#include "geometry.h"
+#include "crossingNumber.h"
+#include <algorithm>
+
+namespace {
+
+int collectVertices(const Figure& fig, Point2D* vertices) {
+    int count = fig.getVertexCount();
+    for (int i = 0; i < count; ++i) {
+        vertices[i] = fig.getVertex(i);
+    }
+    return count;
+}
+
+// Ориентированная площадь треугольника abc, умноженная на 2
+double cross(const Point2D& a, const Point2D& b, const Point2D& c) {
+    return (b.first - a.first) * (c.second - a.second) - (b.second - a.second) * (c.first - a.first);
+}
+
+// p лежит на прямой ab; проверяется, что p внутри прямоугольника отрезка
+bool onSegment(const Point2D& a, const Point2D& b, const Point2D& p) {
+    return std::min(a.first, b.first) <= p.first && p.first <= std::max(a.first, b.first) &&
+           std::min(a.second, b.second) <= p.second && p.second <= std::max(a.second, b.second);
+}
+
+// Отсечение отрезка прямоугольником (Лян - Барски)
+bool segmentIntersectsBox(const Point2D& a, const Point2D& b, const BoundingBox& box) {
+    double t0 = 0.0;
+    double t1 = 1.0;
+    double dx = b.first - a.first;
+    double dy = b.second - a.second;
+    double p[4] = {-dx, dx, -dy, dy};
+    double q[4] = {a.first - box.minX, box.maxX - a.first, a.second - box.minY, box.maxY - a.second};
+
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) return false;
+            continue;
+        }
+        double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+}
+
+BoundingBox BoundingBox::merged(const BoundingBox& other) const {
+    return {std::min(minX, other.minX), std::min(minY, other.minY),
+            std::max(maxX, other.maxX), std::max(maxY, other.maxY)};
+}
+
+double BoundingBox::area() const {
+    return (maxX - minX) * (maxY - minY);
+}
+
+BoundingBox getBoundingBox(const Point2D* vertices, int count) {
+    BoundingBox box = {vertices[0].first, vertices[0].second, vertices[0].first, vertices[0].second};
+    for (int i = 1; i < count; ++i) {
+        box.minX = std::min(box.minX, vertices[i].first);
+        box.minY = std::min(box.minY, vertices[i].second);
+        box.maxX = std::max(box.maxX, vertices[i].first);
+        box.maxY = std::max(box.maxY, vertices[i].second);
+    }
+    return box;
+}
+
+BoundingBox getBoundingBox(const Figure& fig) {
+    Point2D vertices[maxVertexCount];
+    int count = collectVertices(fig, vertices);
+    return getBoundingBox(vertices, count);
+}
+
+bool polygonContains(const Point2D* vertices, int count, const Point2D& p) {
+    bool inside = false;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        inside ^= edgeCrossesRay(vertices[j].first, vertices[j].second,
+                                 vertices[i].first, vertices[i].second, p.first, p.second);
+    }
+    return inside;
+}
+
+bool polygonIntersectsBox(const Point2D* vertices, int count, const BoundingBox& box) {
+    if (!getBoundingBox(vertices, count).intersects(box)) return false;
+
+    for (int i = 0; i < count; ++i) {
+        if (box.contains(vertices[i])) return true;
+    }
+
+    // Прямоугольник целиком внутри многоугольника
+    if (polygonContains(vertices, count, {box.minX, box.minY})) return true;
+
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        if (segmentIntersectsBox(vertices[j], vertices[i], box)) return true;
+    }
+    return false;
+}
+
+bool segmentsIntersect(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+    double d1 = cross(c, d, a);
+    double d2 = cross(c, d, b);
+    double d3 = cross(a, b, c);
+    double d4 = cross(a, b, d);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return true;
+    }
+    return (d1 == 0 && onSegment(c, d, a)) || (d2 == 0 && onSegment(c, d, b)) ||
+           (d3 == 0 && onSegment(a, b, c)) || (d4 == 0 && onSegment(a, b, d));
+}
+
+bool polygonsIntersect(const Point2D* a, int countA, const Point2D* b, int countB) {
+    if (!getBoundingBox(a, countA).intersects(getBoundingBox(b, countB))) return false;
+
+    for (int i = 0, j = countA - 1; i < countA; j = i++) {
+        for (int k = 0, l = countB - 1; k < countB; l = k++) {
+            if (segmentsIntersect(a[j], a[i], b[l], b[k])) return true;
+        }
+    }
+
+    // Границы не пересекаются: либо один многоугольник внутри другого, либо они не пересекаются
+    return polygonContains(b, countB, a[0]) || polygonContains(a, countA, b[0]);
+}
+
+bool figureContains(const Figure& fig, const Point2D& p) {
+    return fig.contains(p);
+}
+
+bool figureIntersectsBox(const Figure& fig, const BoundingBox& box) {
+    Point2D vertices[maxVertexCount];
+    int count = collectVertices(fig, vertices);
+    return polygonIntersectsBox(vertices, count, box);
+}
@@ -0,0 +1,246 @@
+#include "overlap.h"
+#include "rtree.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Вершины фигуры против часовой стрелки и ее прямоугольник
+struct PreparedPolygon {
+    Point2D vertices[maxVertexCount];
+    int count = 0;
+    BoundingBox box;
+};
+
+void orient(PreparedPolygon& poly) {
+    double doubledArea = 0.0;
+    for (int i = 0, j = poly.count - 1; i < poly.count; j = i++) {
+        doubledArea += poly.vertices[j].first * poly.vertices[i].second -
+                       poly.vertices[i].first * poly.vertices[j].second;
+    }
+    if (doubledArea < 0.0) std::reverse(poly.vertices, poly.vertices + poly.count);
+    poly.box = getBoundingBox(poly.vertices, poly.count);
+}
+
+std::vector<PreparedPolygon> prepare(const FigureStore& store) {
+    std::vector<PreparedPolygon> polygons(store.size());
+    for (size_t i = 0; i < store.size(); ++i) {
+        polygons[i].count = static_cast<int>(FigureStore::vertexCount(store.getKind(i)));
+        for (int k = 0; k < polygons[i].count; ++k) {
+            polygons[i].vertices[k] = store.getVertex(i, k);
+        }
+        orient(polygons[i]);
+    }
+    return polygons;
+}
+
+std::vector<PreparedPolygon> prepare(const FigureCollection& figures) {
+    std::vector<PreparedPolygon> polygons(figures.size());
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure& fig = figures[i];
+        polygons[i].count = fig.getVertexCount();
+        for (int k = 0; k < polygons[i].count; ++k) {
+            polygons[i].vertices[k] = fig.getVertex(k);
+        }
+        orient(polygons[i]);
+    }
+    return polygons;
+}
+
+RTree<size_t> buildIndex(const std::vector<PreparedPolygon>& polygons) {
+    std::vector<RTree<size_t>::Item> items;
+    items.reserve(polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        items.push_back({polygons[i].box, i});
+    }
+    RTree<size_t> tree;
+    tree.bulkLoad(std::move(items));
+    return tree;
+}
+
+// Номера многоугольников в порядке листьев дерева: соседние запросы
+// проходят по одним и тем же узлам, которые уже в кэше
+std::vector<size_t> spatialOrder(const RTree<size_t>& tree) {
+    std::vector<size_t> order;
+    order.reserve(tree.size());
+    double inf = std::numeric_limits<double>::infinity();
+    tree.query(BoundingBox{-inf, -inf, inf, inf}, [&order](size_t i, const BoundingBox&) { order.push_back(i); });
+    return order;
+}
+
+std::vector<std::pair<size_t, size_t>> overlappingPairs(const std::vector<PreparedPolygon>& polygons) {
+    RTree<size_t> tree = buildIndex(polygons);
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t i : spatialOrder(tree)) {
+        const PreparedPolygon& a = polygons[i];
+        tree.query(a.box, [&](size_t j, const BoundingBox&) {
+            if (j <= i) return;
+            const PreparedPolygon& b = polygons[j];
+            if (polygonsIntersect(a.vertices, a.count, b.vertices, b.count)) pairs.push_back({i, j});
+        });
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+double cross(const Point2D& u, const Point2D& v) {
+    return u.first * v.second - u.second * v.first;
+}
+
+Point2D sub(const Point2D& a, const Point2D& b) {
+    return {a.first - b.first, a.second - b.second};
+}
+
+// Параметры t на отрезке ab, где он встречает ребра многоугольника
+void crossingParameters(const Point2D& a, const Point2D& b, const PreparedPolygon& poly,
+                        std::vector<double>& params) {
+    Point2D ab = sub(b, a);
+    double lengthSq = ab.first * ab.first + ab.second * ab.second;
+
+    for (int i = 0, j = poly.count - 1; i < poly.count; j = i++) {
+        const Point2D& c = poly.vertices[j];
+        const Point2D& d = poly.vertices[i];
+        Point2D cd = sub(d, c);
+        Point2D ac = sub(c, a);
+        double denom = cross(ab, cd);
+
+        if (denom == 0.0) {
+            // Параллельные ребра: на общей прямой концы cd делят ab
+            if (cross(ab, ac) != 0.0) continue;
+            for (const Point2D& p : {c, d}) {
+                Point2D ap = sub(p, a);
+                params.push_back((ap.first * ab.first + ap.second * ab.second) / lengthSq);
+            }
+            continue;
+        }
+
+        double t = cross(ac, cd) / denom;
+        double u = cross(ac, ab) / denom;
+        if (u >= 0.0 && u <= 1.0) params.push_back(t);
+    }
+}
+
+// Точка p участка ребра (направление dir) многоугольника owner покрыта
+// многоугольником other. Совпадающие ребра одного направления учитываются
+// только у многоугольника с меньшим номером, встречные взаимно уничтожаются.
+bool covers(const PreparedPolygon& other, size_t otherIndex, size_t owner,
+            const Point2D& p, const Point2D& dir) {
+    for (int i = 0, j = other.count - 1; i < other.count; j = i++) {
+        const Point2D& c = other.vertices[j];
+        Point2D cd = sub(other.vertices[i], c);
+        Point2D cp = sub(p, c);
+        double lengthSq = cd.first * cd.first + cd.second * cd.second;
+        double projection = cp.first * cd.first + cp.second * cd.second;
+        if (projection < 0.0 || projection > lengthSq) continue;
+        if (std::abs(cross(cd, cp)) > 1e-9 * lengthSq) continue;
+
+        double sameDirection = dir.first * cd.first + dir.second * cd.second;
+        return sameDirection < 0.0 || otherIndex < owner;
+    }
+    return polygonContains(other.vertices, other.count, p);
+}
+
+double unionArea(const std::vector<PreparedPolygon>& polygons) {
+    RTree<size_t> tree = buildIndex(polygons);
+    std::vector<size_t> neighbours;
+    std::vector<size_t> candidates;
+    std::vector<double> params;
+    std::vector<std::pair<double, double>> spans;
+    double doubledArea = 0.0;
+
+    for (size_t i : spatialOrder(tree)) {
+        const PreparedPolygon& poly = polygons[i];
+        neighbours.clear();
+        tree.query(poly.box, [&](size_t j, const BoundingBox&) {
+            if (j != i) neighbours.push_back(j);
+        });
+
+        for (int k = 0, prev = poly.count - 1; k < poly.count; prev = k++) {
+            const Point2D& a = poly.vertices[prev];
+            const Point2D& b = poly.vertices[k];
+            BoundingBox edgeBox = {std::min(a.first, b.first), std::min(a.second, b.second),
+                                   std::max(a.first, b.first), std::max(a.second, b.second)};
+
+            candidates.clear();
+            for (size_t j : neighbours) {
+                if (polygons[j].box.intersects(edgeBox)) candidates.push_back(j);
+            }
+            if (candidates.empty()) {
+                doubledArea += cross(a, b);
+                continue;
+            }
+
+            // Участки ребра [t0, t1], покрытые каждым из кандидатов
+            Point2D ab = sub(b, a);
+            spans.clear();
+            for (size_t j : candidates) {
+                params.assign({0.0, 1.0});
+                crossingParameters(a, b, polygons[j], params);
+
+                // Ребро не пересекает границу кандидата: оно целиком внутри или снаружи.
+                // Если внутри, ребро покрыто полностью и остальные кандидаты не нужны.
+                if (std::none_of(params.begin(), params.end(), [](double t) { return t > 0.0 && t < 1.0; })) {
+                    Point2D mid = {a.first + ab.first / 2.0, a.second + ab.second / 2.0};
+                    if (covers(polygons[j], j, i, mid, ab)) {
+                        spans.assign({{0.0, 1.0}});
+                        break;
+                    }
+                    continue;
+                }
+                std::sort(params.begin(), params.end());
+
+                for (size_t s = 0; s + 1 < params.size(); ++s) {
+                    double t0 = std::max(params[s], 0.0);
+                    double t1 = std::min(params[s + 1], 1.0);
+                    if (t1 <= t0) continue;
+
+                    double mid = (t0 + t1) / 2.0;
+                    Point2D p = {a.first + ab.first * mid, a.second + ab.second * mid};
+                    if (!covers(polygons[j], j, i, p, ab)) continue;
+                    if (!spans.empty() && spans.back().second == t0) {
+                        spans.back().second = t1;
+                    } else {
+                        spans.push_back({t0, t1});
+                    }
+                }
+            }
+            std::sort(spans.begin(), spans.end());
+
+            // Формула Грина по непокрытым участкам ребра
+            double from = 0.0;
+            spans.push_back({1.0, 1.0});
+            for (const auto& span : spans) {
+                if (span.first > from) {
+                    Point2D p0 = {a.first + ab.first * from, a.second + ab.second * from};
+                    Point2D p1 = {a.first + ab.first * span.first, a.second + ab.second * span.first};
+                    doubledArea += cross(p0, p1);
+                }
+                from = std::max(from, span.second);
+            }
+        }
+    }
+    return doubledArea / 2.0;
+}
+
+}
+
+std::vector<std::pair<size_t, size_t>> findOverlappingPairs(const FigureStore& store) {
+    return overlappingPairs(prepare(store));
+}
+
+std::vector<std::pair<FigureHandle, FigureHandle>> findOverlappingPairs(const FigureCollection& figures) {
+    std::vector<std::pair<FigureHandle, FigureHandle>> result;
+    for (const auto& pair : overlappingPairs(prepare(figures))) {
+        result.push_back({figures.handleAt(pair.first), figures.handleAt(pair.second)});
+    }
+    return result;
+}
+
+double getUnionArea(const FigureStore& store) {
+    return unionArea(prepare(store));
+}
+
+double getUnionArea(const FigureCollection& figures) {
+    return unionArea(prepare(figures));
+}
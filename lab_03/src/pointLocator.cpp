@@ -0,0 +1,198 @@
+#include "pointLocator.h"
+#include "crossingNumber.h"
+#include "parallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+const size_t pointBlock = 16384;
+
+// Сетка не крупнее нескольких миллионов ячеек
+const size_t maxCells = size_t(1) << 22;
+
+}
+
+PointLocator::PointLocator(const FigureStore& store) {
+    std::vector<std::vector<Point2D>> polygons(store.size());
+    for (size_t i = 0; i < store.size(); ++i) {
+        size_t count = FigureStore::vertexCount(store.getKind(i));
+        for (size_t k = 0; k < count; ++k) {
+            polygons[i].push_back(store.getVertex(i, static_cast<int>(k)));
+        }
+    }
+    build(polygons);
+}
+
+PointLocator::PointLocator(const FigureCollection& figures) {
+    std::vector<std::vector<Point2D>> polygons(figures.size());
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure& fig = figures[i];
+        for (int k = 0; k < fig.getVertexCount(); ++k) {
+            polygons[i].push_back(fig.getVertex(k));
+        }
+    }
+    build(polygons);
+}
+
+void PointLocator::build(const std::vector<std::vector<Point2D>>& polygons) {
+    figureCount = polygons.size();
+    if (figureCount > UINT32_MAX) throw std::length_error("Too many figures");
+    if (figureCount == 0) return;
+
+    std::vector<BoundingBox> boxes(figureCount);
+    for (size_t i = 0; i < figureCount; ++i) {
+        if (polygons[i].size() > static_cast<size_t>(slots)) throw std::invalid_argument("Too many vertices");
+        boxes[i] = getBoundingBox(polygons[i].data(), static_cast<int>(polygons[i].size()));
+        bounds = i == 0 ? boxes[i] : bounds.merged(boxes[i]);
+    }
+
+    // Сторона ячейки - не меньше среднего размера фигуры, иначе фигура
+    // копируется во множество ячеек; и не меньше, чем нужно для ~n ячеек
+    double width = std::max(bounds.maxX - bounds.minX, 1e-12);
+    double height = std::max(bounds.maxY - bounds.minY, 1e-12);
+    double meanSide = 0.0;
+    for (const BoundingBox& box : boxes) meanSide += (box.maxX - box.minX) + (box.maxY - box.minY);
+    meanSide /= 2.0 * static_cast<double>(figureCount);
+    double cells = static_cast<double>(std::min(figureCount, maxCells));
+    double side = std::max(meanSide, std::sqrt(width * height / cells));
+    columns = std::max<size_t>(1, std::min<size_t>(maxCells, static_cast<size_t>(width / side)));
+    rows = std::max<size_t>(1, std::min<size_t>(maxCells / columns, static_cast<size_t>(height / side)));
+    scaleX = static_cast<double>(columns) / width;
+    scaleY = static_cast<double>(rows) / height;
+
+    auto cellRange = [this](const BoundingBox& box, size_t& x0, size_t& y0, size_t& x1, size_t& y1) {
+        x0 = std::min(columns - 1, static_cast<size_t>((box.minX - bounds.minX) * scaleX));
+        x1 = std::min(columns - 1, static_cast<size_t>((box.maxX - bounds.minX) * scaleX));
+        y0 = std::min(rows - 1, static_cast<size_t>((box.minY - bounds.minY) * scaleY));
+        y1 = std::min(rows - 1, static_cast<size_t>((box.maxY - bounds.minY) * scaleY));
+    };
+
+    // Два прохода: размеры ячеек, затем заполнение
+    cellStart.assign(columns * rows + 1, 0);
+    for (const BoundingBox& box : boxes) {
+        size_t x0, y0, x1, y1;
+        cellRange(box, x0, y0, x1, y1);
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) ++cellStart[y * columns + x + 1];
+        }
+    }
+    for (size_t c = 0; c + 1 < cellStart.size(); ++c) {
+        if (cellStart[c + 1] > UINT32_MAX - cellStart[c]) throw std::length_error("Too many grid entries");
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    size_t entries = cellStart.back();
+    entryFigure.resize(entries);
+    for (int k = 0; k < slots; ++k) {
+        entryX[k].resize(entries);
+        entryY[k].resize(entries);
+    }
+
+    std::vector<std::uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < figureCount; ++i) {
+        const std::vector<Point2D>& poly = polygons[i];
+        size_t x0, y0, x1, y1;
+        cellRange(boxes[i], x0, y0, x1, y1);
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) {
+                std::uint32_t e = fill[y * columns + x]++;
+                entryFigure[e] = static_cast<std::uint32_t>(i);
+                for (int k = 0; k < slots; ++k) {
+                    const Point2D& v = poly[std::min<size_t>(k, poly.size() - 1)];
+                    entryX[k][e] = v.first;
+                    entryY[k][e] = v.second;
+                }
+            }
+        }
+    }
+}
+
+bool PointLocator::cellOf(const Point2D& p, size_t& cell) const {
+    if (figureCount == 0 || !bounds.contains(p)) return false;
+    size_t x = std::min(columns - 1, static_cast<size_t>((p.first - bounds.minX) * scaleX));
+    size_t y = std::min(rows - 1, static_cast<size_t>((p.second - bounds.minY) * scaleY));
+    cell = y * columns + x;
+    return true;
+}
+
+void PointLocator::testCell(size_t cell, const Point2D& p, unsigned char* inside) const {
+    size_t begin = cellStart[cell];
+    size_t count = cellStart[cell + 1] - begin;
+    const double px = p.first;
+    const double py = p.second;
+
+    // Кандидаты идут блоками; внутренний цикл - по фигурам для одного ребра,
+    // без ветвлений, поэтому компилятор векторизует его. Счетчики - double:
+    // тогда маски сравнений не приходится переводить в другой тип
+    const size_t chunk = 64;
+    for (size_t first = 0; first < count; first += chunk) {
+        size_t width = std::min(count - first, chunk);
+        double crossings[chunk];
+        for (size_t i = 0; i < width; ++i) crossings[i] = 0.0;
+
+        for (int k = 0; k < slots; ++k) {
+            const double* ax = entryX[k].data() + begin + first;
+            const double* ay = entryY[k].data() + begin + first;
+            const double* bx = entryX[(k + 1) % slots].data() + begin + first;
+            const double* by = entryY[(k + 1) % slots].data() + begin + first;
+            for (size_t i = 0; i < width; ++i) {
+                crossings[i] += edgeCrossesRay(ax[i], ay[i], bx[i], by[i], px, py) ? 1.0 : 0.0;
+            }
+        }
+        for (size_t i = 0; i < width; ++i) {
+            inside[first + i] = static_cast<unsigned>(crossings[i]) & 1;
+        }
+    }
+}
+
+size_t PointLocator::locate(const Point2D& p) const {
+    size_t cell;
+    if (!cellOf(p, cell)) return none;
+
+    std::vector<unsigned char> inside(cellStart[cell + 1] - cellStart[cell]);
+    testCell(cell, p, inside.data());
+    for (size_t i = inside.size(); i-- > 0;) {
+        if (inside[i]) return entryFigure[cellStart[cell] + i];
+    }
+    return none;
+}
+
+std::vector<size_t> PointLocator::locate(const std::vector<Point2D>& points, unsigned threads) const {
+    std::vector<size_t> result(points.size(), none);
+    parallelFor(points.size(), pointBlock, [&](size_t begin, size_t end) {
+        std::vector<unsigned char> inside;
+        for (size_t j = begin; j < end; ++j) {
+            size_t cell;
+            if (!cellOf(points[j], cell)) continue;
+            inside.resize(cellStart[cell + 1] - cellStart[cell]);
+            testCell(cell, points[j], inside.data());
+            for (size_t i = inside.size(); i-- > 0;) {
+                if (inside[i]) {
+                    result[j] = entryFigure[cellStart[cell] + i];
+                    break;
+                }
+            }
+        }
+    }, threads);
+    return result;
+}
+
+std::vector<std::uint32_t> PointLocator::countContaining(const std::vector<Point2D>& points,
+                                                         unsigned threads) const {
+    std::vector<std::uint32_t> result(points.size(), 0);
+    parallelFor(points.size(), pointBlock, [&](size_t begin, size_t end) {
+        std::vector<unsigned char> inside;
+        for (size_t j = begin; j < end; ++j) {
+            size_t cell;
+            if (!cellOf(points[j], cell)) continue;
+            inside.resize(cellStart[cell + 1] - cellStart[cell]);
+            testCell(cell, points[j], inside.data());
+            std::uint32_t hits = 0;
+            for (unsigned char flag : inside) hits += flag;
+            result[j] = hits;
+        }
+    }, threads);
+    return result;
+}
@@ -0,0 +1,191 @@
+#include "reportWriter.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const size_t chunkSize = 1 << 20;
+
+}
+
+// Буфер не резервируется заранее: для одной фигуры хватает нескольких сотен
+// байт, а при большом отчете строка сама дорастет до chunkSize
+ReportWriter::ReportWriter(std::ostream& os, ReportFormat format) : os(os), format(format) {}
+
+ReportWriter::~ReportWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+void ReportWriter::write(const Figure& fig) {
+    writeRecord(fig, nullptr);
+}
+
+void ReportWriter::write(const Figure& fig, const FigureHandle& id) {
+    writeRecord(fig, &id);
+}
+
+void ReportWriter::write(const FigureCollection& figures) {
+    for (size_t i = 0; i < figures.size(); ++i) {
+        FigureHandle id = figures.handleAt(i);
+        writeRecord(figures[i], &id);
+    }
+}
+
+void ReportWriter::flush() {
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    os.flush();
+    buffer.clear();
+}
+
+void ReportWriter::writeRecord(const Figure& fig, const FigureHandle* id) {
+    switch (format) {
+        case ReportFormat::Human:
+            writeHuman(fig, id);
+            break;
+        case ReportFormat::Csv:
+            writeCsv(fig, id);
+            break;
+        case ReportFormat::JsonLines:
+            writeJson(fig, id);
+            break;
+    }
+
+    if (buffer.size() >= chunkSize) {
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+void ReportWriter::writeHuman(const Figure& fig, const FigureHandle* id) {
+    if (id) {
+        append("Figure #");
+        appendId(*id);
+        append(": ");
+    }
+
+    append(fig.getName());
+    append(": ");
+    for (int i = 0; i < fig.getVertexCount(); ++i) {
+        auto v = fig.getVertex(i);
+        if (i > 0) append(", ");
+        append("(");
+        appendNumber(v.first);
+        append(", ");
+        appendNumber(v.second);
+        append(")");
+    }
+
+    auto center = fig.getCenter();
+    append("\nGeometric center: (");
+    appendNumber(center.first);
+    append(", ");
+    appendNumber(center.second);
+    append(")\nArea: ");
+    appendNumber(fig.getArea());
+    append("\n--------------------------\n");
+}
+
+void ReportWriter::writeCsv(const Figure& fig, const FigureHandle* id) {
+    if (!headerWritten) {
+        append("id,type,area,center_x,center_y,x1,y1,x2,y2,x3,y3,x4,y4,x5,y5\n");
+        headerWritten = true;
+    }
+
+    if (id) appendId(*id);
+    append(",");
+    append(fig.getName());
+    append(",");
+    appendNumber(fig.getArea());
+    auto center = fig.getCenter();
+    append(",");
+    appendNumber(center.first);
+    append(",");
+    appendNumber(center.second);
+
+    int count = fig.getVertexCount();
+    for (int i = 0; i < 5; ++i) {
+        if (i < count) {
+            auto v = fig.getVertex(i);
+            append(",");
+            appendNumber(v.first);
+            append(",");
+            appendNumber(v.second);
+        } else {
+            append(",,");
+        }
+    }
+    append("\n");
+}
+
+void ReportWriter::writeJson(const Figure& fig, const FigureHandle* id) {
+    append("{");
+    if (id) {
+        append("\"id\":\"");
+        appendId(*id);
+        append("\",");
+    }
+    append("\"type\":\"");
+    append(fig.getName());
+    append("\",\"area\":");
+    appendNumber(fig.getArea());
+
+    auto center = fig.getCenter();
+    append(",\"center\":[");
+    appendNumber(center.first);
+    append(",");
+    appendNumber(center.second);
+    append("],\"vertices\":[");
+    for (int i = 0; i < fig.getVertexCount(); ++i) {
+        auto v = fig.getVertex(i);
+        if (i > 0) append(",");
+        append("[");
+        appendNumber(v.first);
+        append(",");
+        appendNumber(v.second);
+        append("]");
+    }
+    append("]}\n");
+}
+
+void ReportWriter::append(const char* text) {
+    buffer.append(text, std::strlen(text));
+}
+
+void ReportWriter::appendNumber(double value) {
+    char number[32];
+    char* end;
+    if (format == ReportFormat::Human) {
+        // Точность 6 - как у std::cout по умолчанию
+        end = std::to_chars(number, number + sizeof(number), value, std::chars_format::general, 6).ptr;
+    } else if (format == ReportFormat::JsonLines && !std::isfinite(value)) {
+        append("null");
+        return;
+    } else {
+        end = std::to_chars(number, number + sizeof(number), value).ptr;
+    }
+    buffer.append(number, end);
+}
+
+void ReportWriter::appendNumber(std::uint32_t value) {
+    char number[16];
+    char* end = std::to_chars(number, number + sizeof(number), value).ptr;
+    buffer.append(number, end);
+}
+
+void ReportWriter::appendId(const FigureHandle& id) {
+    appendNumber(id.index);
+    buffer.push_back(':');
+    appendNumber(id.generation);
+}
+
+ReportFormat parseReportFormat(const std::string& name) {
+    if (name == "human") return ReportFormat::Human;
+    if (name == "csv") return ReportFormat::Csv;
+    if (name == "jsonl") return ReportFormat::JsonLines;
+    throw std::invalid_argument("Unknown report format: " + name);
+}
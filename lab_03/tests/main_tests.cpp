@@ -2,7 +2,22 @@
 #include "trapezoid.h"
 #include "rhombus.h"
 #include "pentagon.h"
+#include "figureStore.h"
+#include "figureUtils.h"
+#include "figureLoader.h"
+#include "figurePool.h"
+#include "overlap.h"
+#include "parallelSum.h"
+#include "pointLocator.h"
+#include "reportWriter.h"
+#include "batch.h"
+#include "rtree.h"
+#include "slotMap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <sstream>
+#include <thread>
 
 TEST(FigureTest, TrapezoidArea) {
     Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
@@ -30,4 +45,799 @@ TEST(FigureTest, OperatorDouble) {
     Pentagon pent({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 1});
     double area = static_cast<double>(pent);
     EXPECT_NEAR(area, 1.25, 1e-9);
-}
\ No newline at end of file
+}
+
+TEST(FigureTest, PrintUsesTypeName) {
+    std::ostringstream output;
+    output << Rhombus({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    EXPECT_EQ(output.str(), "Rhombus: (0, 0), (2, 0), (3, 1), (1, 1)");
+}
+
+TEST(FigureTest, AssignmentAndEquality) {
+    Pentagon pent({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 1});
+    Pentagon copy;
+    Figure& target = copy;
+    target = static_cast<const Figure&>(pent);
+    EXPECT_TRUE(copy == pent);
+    EXPECT_NEAR(copy.getArea(), 1.25, 1e-9);
+    EXPECT_EQ(copy.vertex<3>(), std::make_pair(0.5, 1.5));
+
+    Trapezoid trap;
+    EXPECT_THROW(target = static_cast<const Figure&>(trap), std::invalid_argument);
+    EXPECT_FALSE(static_cast<const Figure&>(trap) == static_cast<const Figure&>(Rhombus()));
+    EXPECT_THROW(copy.getVertex(5), std::out_of_range);
+}
+
+TEST(FigureStoreTest, AreasAndCentersMatchFigures) {
+    Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
+    Rhombus rhomb({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    Pentagon pent({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 1});
+
+    FigureStore store;
+    store.add(trap);
+    store.add(pent);
+    store.add(rhomb);
+
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.getKind(1), FigureStore::Kind::Pentagon);
+
+    auto areas = store.getAreas();
+    EXPECT_NEAR(areas[0], trap.getArea(), 1e-9);
+    EXPECT_NEAR(areas[1], pent.getArea(), 1e-9);
+    EXPECT_NEAR(areas[2], rhomb.getArea(), 1e-9);
+    EXPECT_NEAR(store.getTotalArea(), 6.0 + 1.25 + 2.0, 1e-9);
+
+    auto centers = store.getCenters();
+    EXPECT_DOUBLE_EQ(centers[0].first, 2.0);
+    EXPECT_DOUBLE_EQ(centers[0].second, 1.0);
+    EXPECT_DOUBLE_EQ(centers[1].first, pent.getCenter().first);
+    EXPECT_DOUBLE_EQ(centers[1].second, pent.getCenter().second);
+}
+
+TEST(FigureStoreTest, ManyFiguresAndMaterialization) {
+    FigureStore store;
+    double expected = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        double s = 1.0 + i % 7;
+        Rhombus rhomb({0, 0}, {s, 0}, {s + 1, 1}, {1, 1});
+        store.add(rhomb);
+        expected += rhomb.getArea();
+    }
+    EXPECT_NEAR(store.getTotalArea(), expected, 1e-6);
+
+    auto fig = store.get(3);
+    EXPECT_TRUE(*fig == Rhombus({0, 0}, {4, 0}, {5, 1}, {1, 1}));
+    EXPECT_THROW(store.get(1000), std::out_of_range);
+}
+
+TEST(FigureVariantTest, AreaCenterAndEquality) {
+    std::vector<FigureVariant> figures;
+    figures.push_back(Trapezoid({0, 0}, {4, 0}, {3, 2}, {1, 2}));
+    figures.push_back(Rhombus({0, 0}, {2, 0}, {3, 1}, {1, 1}));
+    figures.push_back(Pentagon({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 1}));
+
+    EXPECT_NEAR(getArea(figures[0]), 6.0, 1e-9);
+    EXPECT_DOUBLE_EQ(getCenter(figures[0]).first, 2.0);
+    EXPECT_NEAR(getTotalArea(figures), 6.0 + 2.0 + 1.25, 1e-9);
+
+    FigureVariant copy = figures[1];
+    EXPECT_TRUE(copy == figures[1]);
+    EXPECT_FALSE(copy == figures[0]);
+
+    // Трапеция и ромб с одинаковыми вершинами - разные фигуры
+    FigureVariant trap = Trapezoid({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    EXPECT_FALSE(trap == figures[1]);
+
+    copy = figures[2];
+    EXPECT_TRUE(std::holds_alternative<Pentagon>(copy));
+    EXPECT_TRUE(copy == figures[2]);
+}
+
+TEST(FigureVariantTest, ParityWithFigureInterface) {
+    std::vector<std::unique_ptr<Figure>> figures;
+    figures.push_back(createFigure(1));
+    figures.push_back(createFigure(2));
+    figures.push_back(createFigure(3));
+
+    std::vector<FigureVariant> variants;
+    for (const auto& fig : figures) {
+        variants.push_back(toVariant(*fig));
+    }
+    EXPECT_DOUBLE_EQ(getTotalArea(variants), getTotalArea(figures));
+
+    for (size_t i = 0; i < figures.size(); ++i) {
+        std::ostringstream a, b;
+        a << *figures[i];
+        b << variants[i];
+        EXPECT_EQ(a.str(), b.str());
+        EXPECT_TRUE(*toFigure(variants[i]) == *figures[i]);
+    }
+}
+
+TEST(FigureCacheTest, InvalidatedByMutation) {
+    Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
+    EXPECT_NEAR(trap.getArea(), 6.0, 1e-9);
+
+    trap.setVertex(2, {4, 2});
+    trap.setVertex(3, {0, 2});
+    EXPECT_NEAR(trap.getArea(), 8.0, 1e-9);
+    EXPECT_DOUBLE_EQ(trap.getCenter().first, 2.0);
+
+    std::istringstream iss("0 0 2 0 2 2 0 2");
+    iss >> trap;
+    EXPECT_NEAR(static_cast<double>(trap), 4.0, 1e-9);
+
+    Trapezoid other({0, 0}, {1, 0}, {1, 1}, {0, 1});
+    static_cast<Figure&>(trap) = other;
+    EXPECT_NEAR(trap.getArea(), 1.0, 1e-9);
+    EXPECT_DOUBLE_EQ(trap.getCenter().second, 0.5);
+}
+
+TEST(FigureCollectionTest, RunningTotalArea) {
+    FigureCollection figures;
+    EXPECT_DOUBLE_EQ(figures.getTotalArea(), 0.0);
+
+    FigureHandle trap = figures.add(std::make_unique<Trapezoid>(
+        std::make_pair(0.0, 0.0), std::make_pair(4.0, 0.0), std::make_pair(3.0, 2.0), std::make_pair(1.0, 2.0)));
+    FigureHandle rhomb = figures.add(std::make_unique<Rhombus>(
+        std::make_pair(0.0, 0.0), std::make_pair(2.0, 0.0), std::make_pair(3.0, 1.0), std::make_pair(1.0, 1.0)));
+    EXPECT_NEAR(figures.getTotalArea(), 8.0, 1e-9);
+
+    figures.remove(trap);
+    EXPECT_EQ(figures.size(), 1u);
+    EXPECT_NEAR(figures.getTotalArea(), 2.0, 1e-9);
+    EXPECT_NEAR(figures[0].getArea(), 2.0, 1e-9);
+
+    EXPECT_THROW(figures.remove(trap), std::out_of_range);
+    figures.remove(rhomb);
+    EXPECT_TRUE(figures.empty());
+    EXPECT_DOUBLE_EQ(figures.getTotalArea(), 0.0);
+}
+
+TEST(FigureLoaderTest, TextFormat) {
+    std::istringstream input(
+        "# type x1 y1 ...\n"
+        "1 0 0 4 0 3 2 1 2\n"
+        "\n"
+        "2 0 0 2 0 3 1 1 1\r\n"
+        "3 0 0 1 0 1 1 0.5 1.5 0 1");
+
+    FigureStore store;
+    EXPECT_EQ(loadText(input, store), 3u);
+    EXPECT_EQ(store.getKind(1), FigureStore::Kind::Rhombus);
+    EXPECT_NEAR(store.getTotalArea(), 6.0 + 2.0 + 1.25, 1e-9);
+
+    std::ostringstream output;
+    saveText(output, store);
+    std::istringstream again(output.str());
+    FigureCollection figures;
+    EXPECT_EQ(loadText(again, figures), 3u);
+    EXPECT_NEAR(figures.getTotalArea(), 9.25, 1e-9);
+    EXPECT_TRUE(figures[2] == Pentagon({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 1}));
+}
+
+TEST(FigureLoaderTest, TextFormatErrors) {
+    FigureStore store;
+    std::istringstream badType("4 0 0 1 0 1 1 0 1\n");
+    EXPECT_THROW(loadText(badType, store), std::runtime_error);
+    std::istringstream missing("1 0 0 1 0 1 1 0\n");
+    EXPECT_THROW(loadText(missing, store), std::runtime_error);
+    std::istringstream extra("2 0 0 1 0 1 1 0 1 7\n");
+    EXPECT_THROW(loadText(extra, store), std::runtime_error);
+}
+
+TEST(FigureLoaderTest, BinaryFormatRoundTrip) {
+    FigureStore store;
+    for (int i = 0; i < 100; ++i) {
+        store.add(Pentagon({0, 0}, {1.0 * i, 0}, {1, 1}, {0.5, 1.5}, {0, 1}));
+        store.add(Trapezoid({0, 0}, {4, 0}, {3, 2}, {1, 2}));
+    }
+
+    std::string path = testing::TempDir() + "lab_03_figures.bin";
+    saveBinary(path, store);
+
+    {
+        MappedFigureFile file(path);
+        ASSERT_EQ(file.size(), 200u);
+        EXPECT_EQ(file[1].kind, static_cast<std::uint32_t>(FigureStore::Kind::Trapezoid));
+        EXPECT_DOUBLE_EQ(file[2].coords[2], 1.0);
+    }
+
+    FigureStore loaded;
+    EXPECT_EQ(loadFigures(path, loaded), 200u);
+    EXPECT_DOUBLE_EQ(loaded.getTotalArea(), store.getTotalArea());
+
+    FigureCollection figures;
+    EXPECT_EQ(loadBinary(path, figures), 200u);
+    EXPECT_TRUE(figures[3] == Trapezoid({0, 0}, {4, 0}, {3, 2}, {1, 2}));
+    std::remove(path.c_str());
+}
+
+TEST(BatchTest, ParseArguments) {
+    char prog[] = "lab_03_run", batch[] = "--batch", count[] = "--count", n[] = "50",
+         remove[] = "--remove", k[] = "10", seed[] = "--seed", s[] = "7";
+    char* argv[] = {prog, batch, count, n, remove, k, seed, s};
+    ASSERT_TRUE(isBatchMode(8, argv));
+    BatchConfig config = parseBatchArgs(8, argv);
+    EXPECT_EQ(config.figuresPerType, 50u);
+    EXPECT_EQ(config.removeCount, 10u);
+    EXPECT_EQ(config.seed, 7u);
+
+    EXPECT_FALSE(isBatchMode(1, argv));
+    char bad[] = "-5";
+    char* badArgv[] = {prog, batch, count, bad};
+    EXPECT_THROW(parseBatchArgs(4, badArgv), std::invalid_argument);
+    char* tooMany[] = {prog, batch, count, k, remove, n};
+    EXPECT_THROW(parseBatchArgs(6, tooMany), std::invalid_argument);
+}
+
+TEST(BatchTest, RunReportsPhases) {
+    BatchConfig config;
+    config.figuresPerType = 100;
+    config.removeCount = 30;
+
+    std::ostringstream out;
+    runBatch(config, out);
+    std::string report = out.str();
+    EXPECT_NE(report.find("generate"), std::string::npos);
+    EXPECT_NE(report.find("remove"), std::string::npos);
+    EXPECT_NE(report.find("Figures left: 270"), std::string::npos);
+}
+
+TEST(BatchTest, RandomFiguresHaveArea) {
+    std::mt19937 rng(1);
+    for (int type = 1; type <= 3; ++type) {
+        auto fig = randomFigure(type, rng);
+        EXPECT_GT(fig->getArea(), 0.0);
+    }
+    EXPECT_THROW(randomFigure(4, rng), std::invalid_argument);
+}
+
+TEST(GeometryTest, PolygonPredicates) {
+    Rhombus rhomb({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    BoundingBox box = getBoundingBox(rhomb);
+    EXPECT_DOUBLE_EQ(box.minX, 0.0);
+    EXPECT_DOUBLE_EQ(box.maxX, 3.0);
+    EXPECT_DOUBLE_EQ(box.maxY, 1.0);
+
+    EXPECT_TRUE(figureContains(rhomb, {1.5, 0.5}));
+    EXPECT_FALSE(figureContains(rhomb, {0.2, 0.8}));
+
+    // Прямоугольник пересекает ограничивающий, но не сам ромб
+    EXPECT_FALSE(figureIntersectsBox(rhomb, {0.0, 0.7, 0.2, 0.9}));
+    // Ребро проходит через прямоугольник, вершины снаружи
+    EXPECT_TRUE(figureIntersectsBox(rhomb, {1.0, -1.0, 1.2, 2.0}));
+    // Прямоугольник целиком внутри
+    EXPECT_TRUE(figureIntersectsBox(rhomb, {1.4, 0.4, 1.6, 0.6}));
+}
+
+TEST(RTreeTest, MatchesLinearScan) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    std::vector<RTree<int>::Item> items;
+    for (int i = 0; i < 2000; ++i) {
+        double x = coord(rng), y = coord(rng);
+        items.push_back({{x, y, x + 1.0, y + 1.0}, i});
+    }
+
+    RTree<int> bulk;
+    bulk.bulkLoad(items);
+    RTree<int> incremental;
+    for (const auto& item : items) incremental.insert(item.box, item.key);
+    EXPECT_EQ(bulk.size(), 2000u);
+    EXPECT_EQ(incremental.size(), 2000u);
+    EXPECT_LE(bulk.height(), 4);
+
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(bulk.remove(items[i].box, items[i].key));
+        EXPECT_TRUE(incremental.remove(items[i].box, items[i].key));
+    }
+    EXPECT_FALSE(bulk.remove(items[0].box, items[0].key));
+    EXPECT_EQ(bulk.size(), 1500u);
+
+    for (int q = 0; q < 50; ++q) {
+        double x = coord(rng), y = coord(rng);
+        BoundingBox window = {x, y, x + 10.0, y + 10.0};
+        std::vector<int> expected;
+        for (int i = 0; i < 2000; ++i) {
+            if ((i >= 1000 || i % 2 == 1) && items[i].box.intersects(window)) expected.push_back(i);
+        }
+        for (RTree<int>* tree : {&bulk, &incremental}) {
+            std::vector<int> found = tree->query(window);
+            std::sort(found.begin(), found.end());
+            EXPECT_EQ(found, expected);
+        }
+    }
+}
+
+TEST(FigureCollectionTest, SpatialQueriesFollowAddAndRemove) {
+    FigureCollection figures;
+    figures.add(createFigure(2));  // (0,0) (1,0) (1.5,1) (0.5,1)
+    FigureHandle far = figures.add(std::make_unique<Rhombus>(
+        std::make_pair(10.0, 10.0), std::make_pair(12.0, 10.0), std::make_pair(13.0, 11.0), std::make_pair(11.0, 11.0)));
+
+    auto hits = figures.queryPoint({11.5, 10.5});
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0], &figures[far]);
+    EXPECT_TRUE(figures.queryPoint({0.1, 0.9}).empty());
+
+    FigureHandle pent = figures.add(std::make_unique<Pentagon>(
+        std::make_pair(11.0, 10.2), std::make_pair(12.0, 10.2), std::make_pair(12.0, 10.8),
+        std::make_pair(11.5, 10.9), std::make_pair(11.0, 10.8)));
+    EXPECT_EQ(figures.queryPoint({11.5, 10.5}).size(), 2u);
+    EXPECT_EQ(figures.queryWindow({-1.0, -1.0, 20.0, 20.0}).size(), 3u);
+
+    figures.remove(far);
+    hits = figures.queryPoint({11.5, 10.5});
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0], &figures[pent]);
+    EXPECT_EQ(figures.queryWindow({0.0, 0.0, 0.1, 0.1}).size(), 1u);
+}
+
+TEST(SlotMapTest, HandlesSurviveRemovalOfOthers) {
+    SlotMap<int> values;
+    Handle a = values.insert(1);
+    Handle b = values.insert(2);
+    Handle c = values.insert(3);
+
+    EXPECT_TRUE(values.erase(a));
+    EXPECT_EQ(values.size(), 2u);
+    EXPECT_EQ(values[b], 2);
+    EXPECT_EQ(values[c], 3);
+    EXPECT_EQ(values.at(0), 3);  // Последний элемент занял место удаленного
+    EXPECT_EQ(values.handleAt(0), c);
+
+    EXPECT_FALSE(values.contains(a));
+    EXPECT_FALSE(values.erase(a));
+    EXPECT_THROW(values[a], std::out_of_range);
+
+    // Освобожденный слот переиспользуется с новым поколением
+    Handle d = values.insert(4);
+    EXPECT_EQ(d.index, a.index);
+    EXPECT_NE(d.generation, a.generation);
+    EXPECT_FALSE(values.contains(a));
+    EXPECT_EQ(values[d], 4);
+
+    int sum = 0;
+    for (int value : values) sum += value;
+    EXPECT_EQ(sum, 9);
+
+    values.clear();
+    EXPECT_TRUE(values.empty());
+    EXPECT_FALSE(values.contains(b));
+}
+
+TEST(SlotMapTest, HandleTextFormat) {
+    std::ostringstream output;
+    output << Handle{3, 7};
+    EXPECT_EQ(output.str(), "3:7");
+
+    Handle handle;
+    std::istringstream("12:5") >> handle;
+    EXPECT_EQ(handle, (Handle{12, 5}));
+
+    std::istringstream bad("12");
+    EXPECT_FALSE(bad >> handle);
+
+    // Поддельный дескриптор свободного слота не должен считаться действительным
+    SlotMap<int> values;
+    Handle first = values.insert(1);
+    values.insert(2);
+    values.erase(first);
+    EXPECT_FALSE(values.contains(Handle{first.index, first.generation + 1}));
+}
+
+TEST(FigurePoolTest, FiguresArePackedAndPagesReleased) {
+    size_t liveBefore = FigurePool::liveCount();
+    {
+        std::vector<std::unique_ptr<Figure>> figures;
+        for (int i = 0; i < 1000; ++i) {
+            figures.push_back(createFigure(3));
+        }
+        EXPECT_EQ(FigurePool::liveCount(), liveBefore + 1000);
+        EXPECT_GT(FigurePool::pageCount(), 0u);
+
+        // Соседние пятиугольники на одной странице идут подряд
+        auto first = reinterpret_cast<const char*>(figures[0].get());
+        auto second = reinterpret_cast<const char*>(figures[1].get());
+        EXPECT_EQ(static_cast<size_t>(second - first), (sizeof(Pentagon) + 15) / 16 * 16);
+
+        // Освобожденный блок переиспользуется
+        const Figure* freed = figures[500].get();
+        figures[500].reset();
+        figures[500] = createFigure(3);
+        EXPECT_EQ(figures[500].get(), freed);
+    }
+    EXPECT_EQ(FigurePool::liveCount(), liveBefore);
+
+    if (liveBefore == 0) {
+        FigurePool::release();
+        EXPECT_EQ(FigurePool::pageCount(), 0u);
+    }
+}
+
+TEST(FigurePoolTest, ConcurrentAllocateAndFree) {
+    size_t liveBefore = FigurePool::liveCount();
+    const int threadCount = 4;
+    const int perThread = 2000;
+    std::vector<std::vector<std::unique_ptr<Figure>>> batches(threadCount);
+
+    // Каждый поток создает фигуры всех типов и часть сразу удаляет
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&batches, t] {
+            auto& batch = batches[t];
+            for (int i = 0; i < perThread; ++i) {
+                batch.push_back(i % 4 == 3 ? std::make_unique<Trapezoid>() : createFigure(i % 4 + 1));
+                if (i % 3 == 0) batch[batch.size() / 2].reset();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    // Живые блоки не выданы дважды
+    std::vector<const Figure*> pointers;
+    for (const auto& batch : batches) {
+        for (const auto& fig : batch) {
+            if (fig) pointers.push_back(fig.get());
+        }
+    }
+    std::sort(pointers.begin(), pointers.end());
+    EXPECT_EQ(std::adjacent_find(pointers.begin(), pointers.end()), pointers.end());
+    EXPECT_EQ(FigurePool::liveCount(), liveBefore + pointers.size());
+
+    // Удаление не в том потоке, где фигура создана
+    workers.clear();
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&batches, t] { batches[(t + 1) % threadCount].clear(); });
+    }
+    for (auto& worker : workers) worker.join();
+    EXPECT_EQ(FigurePool::liveCount(), liveBefore);
+}
+
+TEST(FigurePoolTest, FallsBackToHeapForLargeBlocks) {
+    void* p = FigurePool::allocate(1024);
+    ASSERT_NE(p, nullptr);
+    FigurePool::deallocate(p, 1024);
+
+    FixedPool pool(32);
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    EXPECT_EQ(static_cast<char*>(b) - static_cast<char*>(a), 32);
+    EXPECT_FALSE(pool.release());
+    pool.deallocate(a);
+    pool.deallocate(b);
+    EXPECT_TRUE(pool.release());
+    EXPECT_EQ(pool.pageCount(), 0u);
+}
+
+TEST(AffineTransformTest, FigureCacheUpdatedAnalytically) {
+    Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
+    EXPECT_NEAR(trap.getArea(), 6.0, 1e-9);
+
+    AffineTransform m = AffineTransform::translation(1.0, -2.0) * AffineTransform::rotation(0.7) *
+                        AffineTransform::scaling(2.0, -3.0);
+    Trapezoid expected(m.apply({0, 0}), m.apply({4, 0}), m.apply({3, 2}), m.apply({1, 2}));
+
+    trap.transform(m);
+    EXPECT_NEAR(trap.getArea(), 36.0, 1e-9);
+    EXPECT_NEAR(trap.getArea(), expected.getArea(), 1e-9);
+    EXPECT_NEAR(trap.getCenter().first, expected.getCenter().first, 1e-9);
+    EXPECT_NEAR(trap.getCenter().second, expected.getCenter().second, 1e-9);
+    EXPECT_EQ(trap.getVertex(2), expected.getVertex(2));
+}
+
+TEST(AffineTransformTest, CollectionAndStore) {
+    FigureCollection figures;
+    FigureStore store;
+    std::mt19937 rng(3);
+    std::vector<FigureHandle> handles;
+    for (int i = 0; i < 30; ++i) {
+        auto fig = randomFigure(i % 3 + 1, rng, 100.0);
+        store.add(*fig);
+        handles.push_back(figures.add(std::move(fig)));
+    }
+    double total = figures.getTotalArea();
+
+    AffineTransform m = AffineTransform::scaling(2.0, 0.5) * AffineTransform::rotation(1.0);
+    figures.transform(m);
+    store.transform(m);
+    EXPECT_NEAR(figures.getTotalArea(), total, 1e-9 * total);
+    EXPECT_NEAR(store.getTotalArea(), total, 1e-9 * total);
+    for (size_t i = 0; i < store.size(); ++i) {
+        EXPECT_NEAR(store.getVertex(i, 1).first, figures[handles[i]].getVertex(1).first, 1e-9);
+    }
+
+    // Растяжение части фигур меняет сумму и положение в R-дереве
+    Point2D inside = figures[handles[4]].getCenter();
+    ASSERT_FALSE(figures.queryPoint(inside).empty());
+    figures.transform({handles[4], handles[7]}, AffineTransform::scaling(3.0, 3.0));
+    store.transform({4, 7}, AffineTransform::scaling(3.0, 3.0));
+    double grown = 8.0 * (figures[handles[4]].getArea() + figures[handles[7]].getArea()) / 9.0;
+    EXPECT_NEAR(figures.getTotalArea(), total + grown, 1e-9 * total);
+    EXPECT_NEAR(store.getTotalArea(), figures.getTotalArea(), 1e-9 * total);
+
+    Point2D moved = figures[handles[4]].getCenter();
+    auto hits = figures.queryPoint(moved);
+    EXPECT_NE(std::find(hits.begin(), hits.end(), &figures[handles[4]]), hits.end());
+
+    FigureHandle stale = handles[0];
+    figures.remove(stale);
+    EXPECT_THROW(figures.transform({handles[1], stale}, m), std::out_of_range);
+    EXPECT_THROW(store.transform({store.size()}, m), std::out_of_range);
+}
+
+TEST(OverlapTest, UnionAreaCountsOverlapOnce) {
+    FigureStore store;
+    auto square = [&store](double x, double y, double size) {
+        std::pair<double, double> v[4] = {{x, y}, {x + size, y}, {x + size, y + size}, {x, y + size}};
+        store.add(FigureStore::Kind::Trapezoid, v);
+    };
+    square(0, 0, 1);
+    square(0.5, 0.5, 1);    // Перекрывает первый на 0.25
+    square(1.5, 0, 1);      // Касается второго ребром
+    square(10, 10, 4);
+    square(11, 11, 1);      // Внутри предыдущего
+    square(10, 10, 4);      // Дубликат
+    square(20, 20, 1);
+
+    EXPECT_NEAR(store.getTotalArea(), 1 + 1 + 1 + 16 + 1 + 16 + 1, 1e-9);
+    EXPECT_NEAR(getUnionArea(store), 1.75 + 1 + 16 + 1, 1e-9);
+
+    std::vector<std::pair<size_t, size_t>> expected = {{0, 1}, {1, 2}, {3, 4}, {3, 5}, {4, 5}};
+    EXPECT_EQ(findOverlappingPairs(store), expected);
+}
+
+TEST(OverlapTest, UnionAreaOfRotatedAndConcaveFigures) {
+    FigureCollection figures;
+    FigureHandle a = figures.add(std::make_unique<Rhombus>(
+        std::make_pair(0.0, 0.0), std::make_pair(2.0, 0.0), std::make_pair(2.0, 2.0), std::make_pair(0.0, 2.0)));
+    // Тот же квадрат, повернутый на 45 градусов вокруг центра: пересечение - правильный восьмиугольник
+    auto rotated = std::make_unique<Rhombus>(std::make_pair(0.0, 0.0), std::make_pair(2.0, 0.0),
+                                             std::make_pair(2.0, 2.0), std::make_pair(0.0, 2.0));
+    rotated->transform(AffineTransform::translation(1, 1) * AffineTransform::rotation(std::acos(-1.0) / 4) *
+                       AffineTransform::translation(-1, -1));
+    FigureHandle b = figures.add(std::move(rotated));
+    // Невыпуклый пятиугольник с вырезом, в который входит квадрат (вершины по часовой стрелке)
+    figures.add(std::make_unique<Pentagon>(std::make_pair(10.0, 0.0), std::make_pair(10.0, 4.0),
+                                           std::make_pair(14.0, 4.0), std::make_pair(12.0, 2.0),
+                                           std::make_pair(14.0, 0.0)));
+    figures.add(std::make_unique<Trapezoid>(std::make_pair(12.0, 1.5), std::make_pair(15.0, 1.5),
+                                            std::make_pair(15.0, 2.5), std::make_pair(12.0, 2.5)));
+
+    double octagon = 8.0 * (std::sqrt(2.0) - 1.0);
+    double notch = 12.0 + 3.0 - 0.25;  // Пятиугольник 12, прямоугольник 3, общая часть 0.25
+    EXPECT_NEAR(getUnionArea(figures), 8.0 - octagon + notch, 1e-9);
+
+    auto pairs = findOverlappingPairs(figures);
+    ASSERT_EQ(pairs.size(), 2u);
+    EXPECT_EQ(pairs[0], std::make_pair(a, b));
+}
+
+TEST(ReportWriterTest, HumanFormatMatchesStreamOutput) {
+    FigureCollection figures;
+    figures.add(std::make_unique<Pentagon>(std::make_pair(0.0, 0.0), std::make_pair(1.0, 0.0),
+                                           std::make_pair(1.0, 1.0), std::make_pair(0.5, 1.5),
+                                           std::make_pair(0.0, 1.0 / 3.0)));
+    FigureHandle id = figures.add(createFigure(2));
+
+    std::ostringstream expected;
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure& fig = figures[i];
+        expected << "Figure #" << figures.handleAt(i) << ": " << fig << "\n"
+                 << "Geometric center: (" << fig.getCenter().first << ", " << fig.getCenter().second << ")\n"
+                 << "Area: " << fig.getArea() << "\n"
+                 << "--------------------------\n";
+    }
+
+    std::ostringstream output;
+    {
+        ReportWriter writer(output);
+        writer.write(figures);
+    }
+    EXPECT_EQ(output.str(), expected.str());
+    EXPECT_NE(output.str().find("Figure #" + std::to_string(id.index) + ":0: Rhombus: (0, 0)"), std::string::npos);
+}
+
+TEST(ReportWriterTest, PrintFigureInfoSameForVariant) {
+    Rhombus rhombus;
+    auto capture = [](auto print) {
+        std::ostringstream output;
+        std::streambuf* old = std::cout.rdbuf(output.rdbuf());
+        print();
+        std::cout.rdbuf(old);
+        return output.str();
+    };
+
+    std::string plain = capture([&] { printFigureInfo(static_cast<const Figure&>(rhombus)); });
+    std::string variant = capture([&] { printFigureInfo(FigureVariant(rhombus)); });
+    EXPECT_EQ(variant, plain);
+    EXPECT_EQ(plain.rfind("Rhombus: ", 0), 0u);
+}
+
+TEST(ReportWriterTest, CsvAndJsonLines) {
+    Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
+    Pentagon pent({0, 0}, {1, 0}, {1, 1}, {0.5, 1.5}, {0, 0.1});
+
+    std::ostringstream csv;
+    {
+        ReportWriter writer(csv, parseReportFormat("csv"));
+        writer.write(trap, Handle{3, 1});
+        writer.write(pent);
+    }
+    EXPECT_EQ(csv.str(),
+              "id,type,area,center_x,center_y,x1,y1,x2,y2,x3,y3,x4,y4,x5,y5\n"
+              "3:1,Trapezoid,6,2,1,0,0,4,0,3,2,1,2,,\n"
+              ",Pentagon,1.025,0.5,0.52,0,0,1,0,1,1,0.5,1.5,0,0.1\n");
+
+    std::ostringstream json;
+    ReportWriter writer(json, ReportFormat::JsonLines);
+    writer.write(trap, Handle{0, 2});
+    EXPECT_TRUE(json.str().empty());
+    writer.flush();
+    EXPECT_EQ(json.str(),
+              "{\"id\":\"0:2\",\"type\":\"Trapezoid\",\"area\":6,\"center\":[2,1],"
+              "\"vertices\":[[0,0],[4,0],[3,2],[1,2]]}\n");
+
+    EXPECT_THROW(parseReportFormat("xml"), std::invalid_argument);
+}
+
+TEST(ParallelSumTest, TotalAreaDoesNotDependOnThreadCount) {
+    std::mt19937 rng(11);
+    std::vector<std::unique_ptr<Figure>> figures;
+    std::vector<FigureVariant> variants;
+    long double reference = 0.0L;
+    for (int i = 0; i < 50000; ++i) {
+        figures.push_back(randomFigure(i % 3 + 1, rng));
+        variants.push_back(toVariant(*figures.back()));
+        reference += figures.back()->getArea();
+    }
+    figures.push_back(nullptr);
+
+    double single = getTotalArea(figures, 1);
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+        EXPECT_EQ(getTotalArea(figures, threads), single);
+        EXPECT_EQ(getTotalArea(variants, threads), single);
+    }
+    EXPECT_NEAR(single, static_cast<double>(reference), 1e-12 * single);
+
+    // Попарная сумма не накапливает ошибку на длинных рядах одинаковых слагаемых
+    double tenth = parallelSum(10000000, [](size_t) { return 0.1; }, 4);
+    EXPECT_NEAR(tenth, 1e6, 1e-7);
+    EXPECT_EQ(parallelSum(0, [](size_t) { return 1.0; }), 0.0);
+}
+
+TEST(PointLocatorTest, FigureContains) {
+    Pentagon pent({0, 0}, {2, 0}, {3, 2}, {1, 3}, {-1, 2});
+    EXPECT_TRUE(pent.contains({1.0, 1.0}));
+    EXPECT_FALSE(pent.contains({3.0, 3.0}));
+    EXPECT_FALSE(pent.contains({-1.0, 0.5}));
+
+    Trapezoid trap({0, 0}, {4, 0}, {3, 2}, {1, 2});
+    EXPECT_TRUE(trap.contains({2.0, 1.0}));
+    EXPECT_FALSE(trap.contains({0.2, 1.8}));
+    EXPECT_EQ(trap.contains({0.2, 1.8}), figureContains(trap, {0.2, 1.8}));
+}
+
+TEST(PointLocatorTest, MatchesFigureContains) {
+    std::mt19937 rng(21);
+    FigureCollection figures;
+    FigureStore store;
+    for (int i = 0; i < 2000; ++i) {
+        auto fig = randomFigure(i % 3 + 1, rng, 200.0);
+        store.add(*fig);
+        figures.add(std::move(fig));
+    }
+
+    std::uniform_real_distribution<double> coord(-20.0, 220.0);
+    std::vector<Point2D> points(20000);
+    for (auto& p : points) p = {coord(rng), coord(rng)};
+
+    PointLocator byStore(store);
+    PointLocator byCollection(figures);
+    EXPECT_EQ(byStore.size(), 2000u);
+
+    std::vector<size_t> top = byStore.locate(points, 1);
+    std::vector<std::uint32_t> counts = byStore.countContaining(points, 1);
+    size_t hits = 0;
+    for (size_t j = 0; j < points.size(); ++j) {
+        size_t expectedTop = PointLocator::none;
+        std::uint32_t expectedCount = 0;
+        for (size_t i = 0; i < figures.size(); ++i) {
+            if (figureContains(figures[i], points[j])) {
+                expectedTop = i;
+                ++expectedCount;
+            }
+        }
+        ASSERT_EQ(top[j], expectedTop) << j;
+        ASSERT_EQ(counts[j], expectedCount) << j;
+        EXPECT_EQ(byStore.locate(points[j]), expectedTop);
+        if (expectedCount > 0) ++hits;
+    }
+    EXPECT_GT(hits, 0u);
+
+    // Результат не зависит от числа потоков и от источника фигур
+    for (unsigned threads : {2u, 4u, 0u}) {
+        EXPECT_EQ(byStore.locate(points, threads), top);
+        EXPECT_EQ(byCollection.countContaining(points, threads), counts);
+    }
+}
+
+TEST(PointLocatorTest, EmptyAndOutside) {
+    PointLocator empty{FigureStore()};
+    EXPECT_EQ(empty.locate({0.0, 0.0}), PointLocator::none);
+    EXPECT_TRUE(empty.locate(std::vector<Point2D>()).empty());
+
+    FigureStore store;
+    store.add(Rhombus({0, 0}, {2, 0}, {3, 1}, {1, 1}));
+    PointLocator one(store);
+    EXPECT_EQ(one.locate({1.5, 0.5}), 0u);
+    EXPECT_EQ(one.locate({0.2, 0.8}), PointLocator::none);
+    EXPECT_EQ(one.locate({10.0, 10.0}), PointLocator::none);
+}
+
+TEST(FigureHashTest, TypeTagAndHashMatchEquality) {
+    Rhombus rhomb({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    Trapezoid trap({0, 0}, {2, 0}, {3, 1}, {1, 1});
+    EXPECT_EQ(rhomb.getType(), FigureType::Rhombus);
+    EXPECT_EQ(trap.getType(), FigureType::Trapezoid);
+    EXPECT_EQ(Pentagon().getType(), FigureType::Pentagon);
+
+    // Те же вершины, но другой тип
+    EXPECT_FALSE(rhomb == static_cast<const Figure&>(trap));
+    EXPECT_NE(rhomb.hash(), trap.hash());
+    EXPECT_THROW(static_cast<Figure&>(rhomb) = static_cast<const Figure&>(trap), std::invalid_argument);
+
+    Rhombus copy = rhomb;
+    EXPECT_EQ(std::hash<Figure>()(copy), rhomb.hash());
+    copy.setVertex(0, {-0.0, 0.0});
+    EXPECT_EQ(copy.hash(), rhomb.hash());
+
+    // Кэш хэша сбрасывается при любом изменении вершин
+    size_t before = copy.hash();
+    copy.setVertex(0, {0.5, 0.0});
+    EXPECT_NE(copy.hash(), before);
+    copy.setVertex(0, {0.0, 0.0});
+    copy.transform(AffineTransform::translation(1.0, 0.0));
+    EXPECT_NE(copy.hash(), rhomb.hash());
+    copy.transform(AffineTransform::translation(-1.0, 0.0));
+    EXPECT_EQ(copy.hash(), rhomb.hash());
+    std::istringstream input("0 0 2 0 3 1 1 1");
+    input >> copy;
+    EXPECT_EQ(copy.hash(), rhomb.hash());
+}
+
+TEST(FigureHashTest, RemoveDuplicates) {
+    std::mt19937 rng(5);
+    std::vector<std::unique_ptr<Figure>> figures;
+    std::vector<std::unique_ptr<Figure>> unique;
+    for (int i = 0; i < 1000; ++i) {
+        unique.push_back(randomFigure(i % 3 + 1, rng));
+    }
+    for (int i = 0; i < 3000; ++i) {
+        const Figure& source = *unique[(i * 7) % unique.size()];
+        figures.push_back(toFigure(toVariant(source)));
+    }
+    figures.push_back(nullptr);
+
+    EXPECT_EQ(removeDuplicates(figures), 2000u);
+    ASSERT_EQ(figures.size(), 1001u);
+    for (size_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(*figures[i] == *unique[(i * 7) % unique.size()]);
+    }
+    EXPECT_EQ(figures.back(), nullptr);
+
+    FigureCollection collection;
+    FigureHandle first = collection.add(std::make_unique<Pentagon>());
+    collection.add(std::make_unique<Rhombus>());
+    collection.add(std::make_unique<Pentagon>());
+    FigureHandle moved = collection.add(std::make_unique<Trapezoid>());
+    collection.transform({moved}, AffineTransform::translation(1.0, 1.0));
+    collection.add(std::make_unique<Rhombus>());
+
+    EXPECT_EQ(removeDuplicates(collection), 2u);
+    EXPECT_EQ(collection.size(), 3u);
+    EXPECT_TRUE(collection.contains(first));
+    EXPECT_TRUE(collection.contains(moved));
+    EXPECT_EQ(removeDuplicates(collection), 0u);
+}
@@ -0,0 +1,22 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstddef>
+#include <iostream>
+
+// Неинтерактивный режим lab_04_run:
+//     lab_04_run --bench [--count N] [--seed S]
+// Для каждой инстанциации фигур (double, float, int32_t, int64_t) создает
+// по N случайных треугольников, шестиугольников и восьмиугольников и печатает
+// время создания, суммарной площади (totalArea и блочной totalArea в одном
+// потоке и на всех ядрах) и расчета центров.
+struct BenchConfig {
+    size_t figuresPerType = 100000;
+    unsigned seed = 42;
+};
+
+bool isBenchMode(int argc, char* argv[]);
+BenchConfig parseBenchArgs(int argc, char* argv[]);
+void runBench(const BenchConfig& config, std::ostream& os);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef FIGURES_H
 #define FIGURES_H
 
+#include "parallelFor.h"
 #include <iostream>
 #include <array>
 #include <utility>
@@ -9,21 +10,34 @@
 #include <stdexcept>
 #include <vector>
 #include <concepts>
+#include <typeinfo>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numbers>
+#include <span>
+#include <ranges>
 
 template <typename T>
 concept Number = std::floating_point<T> || std::integral<T>;
 
+// Удвоенная площадь треугольника с целыми вершинами считается в 128 битах:
+// разности координат и их произведения не переполняются (расширение GCC/Clang)
+__extension__ using WideInt = __int128;
+
 template<Number T>
 class Point {
 public:
     T x, y;
     
-    Point();
-    Point(T x, T y);
+    // В заголовке, чтобы создание точек встраивалось в циклы StaticFigure
+    Point() : x(0), y(0) {}
+    Point(T x, T y) : x(x), y(y) {}
     
-    Point(const Point& other);
+    // Тривиальное копирование: массивы точек копируются как memcpy
+    Point(const Point& other) = default;
     
-    Point& operator=(const Point& other);
+    Point& operator=(const Point& other) = default;
     
     Point operator+(const Point& other) const;
     Point operator-(const Point& other) const;
@@ -36,8 +50,8 @@ public:
     
     double distance(const Point& other) const;
     
-    template<Number U>
-    friend std::ostream& operator<<(std::ostream& os, const Point<U>& p) {
+    // Не шаблон: шаблонный друг определялся бы заново в каждой инстанциации Point
+    friend std::ostream& operator<<(std::ostream& os, const Point& p) {
         os << "(" << p.x << ", " << p.y << ")";
         return os;
     }
@@ -65,23 +79,101 @@ public:
     operator double() const {
         return area();
     }
+
+protected:
+    // Копирование только из наследников; без явного объявления неявный
+    // конструктор копирования устарел из-за объявленного operator=
+    Figure() = default;
+    Figure(const Figure& other) = default;
 };
 
+// Статический интерфейс фигуры (CRTP). Вызовы идут напрямую в методы Derived,
+// без виртуальной диспетчеризации, и встраиваются в циклы, где тип фигуры
+// известен. Конкретные фигуры наследуют и Figure<T>, и StaticFigure, а
+// виртуальные методы и статические - одна и та же реализация
+template <class Derived, Number T>
+class StaticFigure {
+public:
+    using Coordinate = T;
+
+    double area() const { return derived().Derived::area(); }
+    Point<double> geometricCenter() const { return derived().Derived::geometricCenter(); }
+    bool isRegular() const { return derived().Derived::isRegular(); }
+
+    // Копия с точным типом, а не указатель на Figure<T>
+    std::shared_ptr<Derived> clone() const { return std::make_shared<Derived>(derived()); }
+
+protected:
+    StaticFigure() = default;
+
+private:
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
+template <class F>
+concept StaticFigureType = std::derived_from<F, StaticFigure<F, typename F::Coordinate>>;
+
+// Пакетные алгоритмы для фигур одного типа, например PackedArray::group<U>().
+// Тип известен при компиляции, поэтому area() и geometricCenter() встраиваются
+// и тело цикла не содержит вызовов
+template <std::ranges::input_range Range>
+    requires StaticFigureType<std::ranges::range_value_t<Range>>
+double sum_area(const Range& figures) {
+    using F = std::ranges::range_value_t<Range>;
+    double total = 0;
+    for (const F& figure : figures) {
+        total += static_cast<const StaticFigure<F, typename F::Coordinate>&>(figure).area();
+    }
+    return total;
+}
+
+// Центры фигур в порядке обхода; возвращает итератор за последним записанным
+template <std::ranges::input_range Range, std::output_iterator<Point<double>> Out>
+    requires StaticFigureType<std::ranges::range_value_t<Range>>
+Out centers(const Range& figures, Out out) {
+    using F = std::ranges::range_value_t<Range>;
+    for (const F& figure : figures) {
+        *out++ = static_cast<const StaticFigure<F, typename F::Coordinate>&>(figure).geometricCenter();
+    }
+    return out;
+}
+
+// Вершины хранятся в самом объекте, без отдельных выделений памяти
 template<Number T>
-class Triangle : public Figure<T> {
+class Triangle : public Figure<T>, public StaticFigure<Triangle<T>, T> {
 private:
-    std::array<std::shared_ptr<Point<T>>, 3> vertices; 
+    std::array<Point<T>, 3> vertices;
     
 public:
     Triangle();
     Triangle(const std::array<Point<T>, 3>& points);
-    Triangle(const Triangle& other);
+    Triangle(const Triangle& other) = default;
+    Triangle(Triangle&& other) noexcept = default;
+    // Явно: умолчательное присваивание вызвало бы чисто виртуальный Figure::operator=
     Triangle& operator=(const Triangle& other);
-    Triangle(Triangle&& other) noexcept;
     Triangle& operator=(Triangle&& other) noexcept;
     
-    Point<double> geometricCenter() const override;
-    double area() const override;
+    // Определены здесь, чтобы встраиваться через StaticFigure
+    Point<double> geometricCenter() const override {
+        double centerX = (static_cast<double>(vertices[0].x) + vertices[1].x + vertices[2].x) / 3.0;
+        double centerY = (static_cast<double>(vertices[0].y) + vertices[1].y + vertices[2].y) / 3.0;
+        return Point<double>(centerX, centerY);
+    }
+
+    double area() const override {
+        if constexpr (std::integral<T>) {
+            // Единственное округление - при переводе точного результата в double
+            WideInt doubled = doubledArea();
+            return static_cast<double>(doubled < 0 ? -doubled : doubled) / 2.0;
+        } else {
+            double x1 = vertices[0].x, y1 = vertices[0].y;
+            double x2 = vertices[1].x, y2 = vertices[1].y;
+            double x3 = vertices[2].x, y3 = vertices[2].y;
+
+            return std::abs((x1*(y2-y3) + x2*(y3-y1) + x3*(y1-y2)) / 2.0);
+        }
+    }
+
     void printVertices(std::ostream& os) const override;
     void readVertices(std::istream& is) override;
     
@@ -92,82 +184,437 @@ public:
     
     bool isRegular() const override;
     
-    const std::array<std::shared_ptr<Point<T>>, 3>& getVertices() const { return vertices; } 
+    // Для целых координат - удвоенная площадь со знаком, без округлений.
+    // Точна, пока координаты по модулю меньше 2^62
+    WideInt doubledArea() const requires std::integral<T> {
+        WideInt ax = static_cast<WideInt>(vertices[1].x) - vertices[0].x;
+        WideInt ay = static_cast<WideInt>(vertices[1].y) - vertices[0].y;
+        WideInt bx = static_cast<WideInt>(vertices[2].x) - vertices[0].x;
+        WideInt by = static_cast<WideInt>(vertices[2].y) - vertices[0].y;
+        return ax * by - bx * ay;
+    }
+    
+    // Представление без копирования вершин
+    std::span<const Point<T>, 3> getVertices() const { return vertices; }
 };
 
-template<Number T>
-class Hexagon : public Figure<T> {
+// Направления на вершины правильного N-угольника: cos и sin углов 2*pi*i/N.
+// Таблица считается при компиляции. Угол сводится к четверти оборота q и
+// остатку не больше pi/4, для остатка берется ряд Тейлора; на осях
+// значения точные (sin(pi) == 0)
+struct UnitVector {
+    double dx, dy;
+};
+
+template<int N>
+class UnitCircle {
+    static constexpr UnitVector direction(int i) {
+        int q = (4 * i + N / 2) / N;
+        double r = std::numbers::pi * (4 * i - q * N) / (2.0 * N);
+
+        // term = r^k / k!, знаки чередуются через два члена
+        double cosR = 0, sinR = 0, term = 1;
+        for (int k = 0; k < 20; ++k) {
+            double signedTerm = (k / 2) % 2 == 0 ? term : -term;
+            if (k % 2 == 0) cosR += signedTerm; else sinR += signedTerm;
+            term *= r / (k + 1);
+        }
+
+        switch (q % 4) {
+            case 1: return {-sinR, cosR};
+            case 2: return {-cosR, -sinR};
+            case 3: return {sinR, -cosR};
+            default: return {cosR, sinR};
+        }
+    }
+
+public:
+    static_assert(N >= 3, "Polygon needs at least 3 vertices");
+    static constexpr std::array<UnitVector, N> table = [] {
+        std::array<UnitVector, N> result{};
+        for (int i = 0; i < N; ++i) result[i] = direction(i);
+        return result;
+    }();
+};
+
+// Вершины правильного N-угольника, вычисляемые по одной при обходе:
+// center + radius * направление из таблицы, без временного массива.
+// Итератор хранит копию центра и радиуса и не зависит от времени жизни диапазона
+template<Number T, int N>
+class RegularVertices {
+public:
+    class Iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Point<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Point<T>;
+
+        Iterator() = default;
+        Iterator(const Point<T>& center, T radius, int index) : center(center), radius(radius), index(index) {}
+
+        Point<T> operator*() const { return vertexAt(center, radius, index); }
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++index; return old; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+
+    private:
+        Point<T> center;
+        T radius{};
+        int index = 0;
+    };
+
+    RegularVertices(const Point<T>& center, T radius) : center(center), radius(radius) {}
+
+    Iterator begin() const { return Iterator(center, radius, 0); }
+    Iterator end() const { return Iterator(center, radius, N); }
+    static constexpr std::size_t size() { return N; }
+
+    Point<T> operator[](int index) const {
+        if (index < 0 || index >= N) throw std::out_of_range("Vertex index out of range");
+        return vertexAt(center, radius, index);
+    }
+
 private:
     Point<T> center;
     T radius;
-    
-    std::array<Point<T>, 6> calculateVertices() const;
-    
-public:
-    Hexagon();
-    Hexagon(const Point<T>& center, T radius);
-    Hexagon(const Hexagon& other);
-    Hexagon& operator=(const Hexagon& other);
-    
-    Point<double> geometricCenter() const override;
-    double area() const override;
-    void printVertices(std::ostream& os) const override;
-    void readVertices(std::istream& is) override;
-    
-    bool operator==(const Figure<T>& other) const override;
-    Hexagon& operator=(const Figure<T>& other) override;
-    
-    std::shared_ptr<Figure<T>> clone() const override;
-    
-    bool isRegular() const override; 
-    
-    const Point<T>& getCenter() const { return center; }
-    T getRadius() const { return radius; }
+
+    static Point<T> vertexAt(const Point<T>& center, T radius, int index) {
+        const UnitVector& d = UnitCircle<N>::table[index];
+        return Point<T>(static_cast<T>(center.x + radius * d.dx), static_cast<T>(center.y + radius * d.dy));
+    }
 };
 
-template<Number T>
-class Octagon : public Figure<T> {
+// Название для вывода; nullptr - печатается "Regular N-gon"
+constexpr const char* regularPolygonName(int n) {
+    switch (n) {
+        case 3: return "Equilateral triangle";
+        case 4: return "Square";
+        case 5: return "Pentagon";
+        case 6: return "Hexagon";
+        case 7: return "Heptagon";
+        case 8: return "Octagon";
+        case 9: return "Nonagon";
+        case 10: return "Decagon";
+        case 12: return "Dodecagon";
+        default: return nullptr;
+    }
+}
+
+// Правильный N-угольник, заданный центром и радиусом описанной окружности.
+// Площадь - constexpr коэффициент, умноженный на r^2, вершины берутся из
+// UnitCircle<N>. Методы определены в заголовке, чтобы работал любой N
+template<Number T, int N>
+class RegularPolygon : public Figure<T>, public StaticFigure<RegularPolygon<T, N>, T> {
 private:
     Point<T> center;
     T radius;
     
-    std::array<Point<T>, 8> calculateVertices() const;
-    
 public:
-    Octagon();
-    Octagon(const Point<T>& center, T radius);
-    Octagon(const Octagon& other);
-    Octagon& operator=(const Octagon& other);
-    
-    Point<double> geometricCenter() const override;
-    double area() const override;
+    static constexpr int vertexCount = N;
+    static constexpr const char* name = regularPolygonName(N);
+
+    // Площадь при единичном радиусе: N/2 * sin(2*pi/N)
+    static constexpr double areaCoefficient = N / 2.0 * UnitCircle<N>::table[1].dy;
+
+    RegularPolygon();
+    RegularPolygon(const Point<T>& center, T radius);
+    RegularPolygon(const RegularPolygon& other) = default;
+    // Явно: умолчательное присваивание вызвало бы чисто виртуальный Figure::operator=
+    RegularPolygon& operator=(const RegularPolygon& other);
+    
+    // Определены здесь, чтобы встраиваться через StaticFigure
+    Point<double> geometricCenter() const override { return Point<double>(center.x, center.y); }
+    double area() const override { return areaCoefficient * radius * radius; }
     void printVertices(std::ostream& os) const override;
     void readVertices(std::istream& is) override;
     
     bool operator==(const Figure<T>& other) const override;
-    Octagon& operator=(const Figure<T>& other) override;
+    RegularPolygon& operator=(const Figure<T>& other) override;
     
-    std::shared_ptr<Figure<T>> clone() const override; 
+    std::shared_ptr<Figure<T>> clone() const override;
     
-    bool isRegular() const override; 
+    // Правильность следует из типа и известна при компиляции
+    constexpr bool isRegular() const override { return true; }
     
     const Point<T>& getCenter() const { return center; }
     T getRadius() const { return radius; }
+    RegularVertices<T, N> vertices() const { return {center, radius}; }
+};
+
+template<Number T>
+using Hexagon = RegularPolygon<T, 6>;
+
+template<Number T>
+using Octagon = RegularPolygon<T, 8>;
+
+template<Number T, int N>
+RegularPolygon<T, N>::RegularPolygon() : center(0, 0), radius(0) {}
+
+template<Number T, int N>
+RegularPolygon<T, N>::RegularPolygon(const Point<T>& center, T radius) : center(center), radius(radius) {}
+
+template<Number T, int N>
+RegularPolygon<T, N>& RegularPolygon<T, N>::operator=(const RegularPolygon& other) {
+    center = other.center;
+    radius = other.radius;
+    return *this;
+}
+
+template<Number T, int N>
+void RegularPolygon<T, N>::printVertices(std::ostream& os) const {
+    if constexpr (name != nullptr) {
+        os << name << " vertices: ";
+    } else {
+        os << "Regular " << N << "-gon vertices: ";
+    }
+    for (const auto& vertex : vertices()) {
+        os << "(" << vertex.x << ", " << vertex.y << ") ";
+    }
+    os << "(Center: " << center << ", Radius: " << radius << ")";
+}
+
+template<Number T, int N>
+void RegularPolygon<T, N>::readVertices(std::istream& is) {
+    T x, y, r;
+    is >> x >> y >> r;
+    center = Point<T>(x, y);
+    radius = r;
+}
+
+template<Number T, int N>
+bool RegularPolygon<T, N>::operator==(const Figure<T>& other) const {
+    const RegularPolygon* otherPolygon = dynamic_cast<const RegularPolygon*>(&other);
+    if (!otherPolygon) return false;
+    
+    return center == otherPolygon->center && radius == otherPolygon->radius;
+}
+
+template<Number T, int N>
+RegularPolygon<T, N>& RegularPolygon<T, N>::operator=(const Figure<T>& other) {
+    const RegularPolygon* otherPolygon = dynamic_cast<const RegularPolygon*>(&other);
+    if (otherPolygon) {
+        *this = *otherPolygon;
+    }
+    return *this;
+}
+
+template<Number T, int N>
+std::shared_ptr<Figure<T>> RegularPolygon<T, N>::clone() const {
+    return std::make_shared<RegularPolygon>(*this);
+}
+
+// Используемые в программе варианты собираются один раз, в figures.cpp
+extern template class RegularPolygon<double, 6>;
+extern template class RegularPolygon<double, 8>;
+extern template class RegularPolygon<float, 6>;
+extern template class RegularPolygon<float, 8>;
+extern template class RegularPolygon<std::int32_t, 6>;
+extern template class RegularPolygon<std::int32_t, 8>;
+extern template class RegularPolygon<std::int64_t, 6>;
+extern template class RegularPolygon<std::int64_t, 8>;
+
+namespace areaDetail {
+
+// Порядок сложения зависит только от размера блока, но не от числа потоков
+inline constexpr size_t blockSize = 2048;
+
+// Попарная сумма: ошибка округления растет как O(log n)
+inline double pairwiseSum(const double* values, size_t count) {
+    if (count <= 8) {
+        double sum = 0;
+        for (size_t i = 0; i < count; ++i) sum += values[i];
+        return sum;
+    }
+    size_t half = count / 2;
+    return pairwiseSum(values, half) + pairwiseSum(values + half, count - half);
+}
+
+template <class T>
+struct FigureNumber {};
+
+template <Number U>
+struct FigureNumber<Figure<U>> {
+    using type = U;
 };
 
-template <class T> 
+// Площади фигур одного блока. Для Triangle, Hexagon и Octagon тип
+// проверяется по typeid, и area() вызывается по квалифицированному имени:
+// без виртуального вызова и встроенной (определения в заголовке), по той же
+// формуле, что и виртуальный area(). Остальные фигуры - через виртуальный area().
+// Раскладка координат в отдельные массивы для векторного цикла оказалась
+// медленнее: сбор и обратная раскладка по индексам стоили больше, чем
+// экономил векторный расчет
+template <Number U>
+void blockAreas(const std::shared_ptr<Figure<U>>* figures, size_t count, double* areas) {
+    for (size_t i = 0; i < count; ++i) {
+        const Figure<U>& figure = *figures[i];
+        // Сравниваются адреса type_info: это дешевле operator==, который при
+        // несовпадении сравнивает строки. Если у типа окажется несколько
+        // type_info (разные библиотеки), фигура просто пойдет через area()
+        const std::type_info* type = &typeid(figure);
+        if (type == &typeid(Triangle<U>)) {
+            areas[i] = static_cast<const Triangle<U>&>(figure).Triangle<U>::area();
+        } else if (type == &typeid(Hexagon<U>)) {
+            areas[i] = static_cast<const Hexagon<U>&>(figure).Hexagon<U>::area();
+        } else if (type == &typeid(Octagon<U>)) {
+            areas[i] = static_cast<const Octagon<U>&>(figure).Octagon<U>::area();
+        } else {
+            areas[i] = figure.area();
+        }
+    }
+}
+}
+
+// Фигуры хранятся умными указателями; Allocator выделяет и сами фигуры
+// (emplace), и массив указателей. Методы определены в заголовке, чтобы
+// работал любой аллокатор
+template <class T, class Allocator = std::allocator<T>>
 class Array {
 private:
-    std::vector<std::shared_ptr<T>> data; // Хранение умными указателями 
+    using PointerAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::shared_ptr<T>>;
+    using Storage = std::vector<std::shared_ptr<T>, PointerAllocator>;
+
+    Storage data; // Хранение умными указателями 
+    Allocator allocator;
+
 public:
+    using value_type = std::shared_ptr<T>;
+    using allocator_type = Allocator;
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+
+    Array() = default;
+    explicit Array(const Allocator& allocator);
+
     void add(std::shared_ptr<T> elem); 
+
+    // Создает фигуру прямо в памяти от Allocator, вместе с блоком счетчика ссылок
+    template <class U, class... Args>
+        requires std::derived_from<U, T>
+    U& emplace(Args&&... args);
+
     void remove(size_t index);
     double totalArea() const;
+
+    // Та же сумма в нескольких потоках (threads = 0 - по числу ядер), с
+    // площадями известных типов фигур без виртуальных вызовов. Блоки фиксированного размера
+    // и их суммы складываются попарно в одном порядке, поэтому результат
+    // побитово одинаков при любом числе потоков
+    double totalArea(unsigned threads) const;
+
     void printAll() const;
     size_t size() const;
     std::shared_ptr<T>& get(size_t index);  
+
+    void reserve(size_t count);
+    size_t capacity() const;
+    allocator_type get_allocator() const { return allocator; }
+
+    iterator begin() { return data.begin(); }
+    iterator end() { return data.end(); }
+    const_iterator begin() const { return data.begin(); }
+    const_iterator end() const { return data.end(); }
 };
 
+template <class T, class Allocator>
+Array<T, Allocator>::Array(const Allocator& allocator) : data(PointerAllocator(allocator)), allocator(allocator) {}
+
+template <class T, class Allocator>
+void Array<T, Allocator>::add(std::shared_ptr<T> elem) {
+    data.push_back(std::move(elem));
+}
+
+template <class T, class Allocator>
+void Array<T, Allocator>::remove(size_t index) {
+    if (index < data.size()) {
+        data.erase(data.begin() + index);
+    }
+}
+
+template <class T, class Allocator>
+double Array<T, Allocator>::totalArea() const {
+    double total = 0;
+    for (const auto& elem : data) {
+        total += static_cast<double>(*elem);
+    }
+    return total;
+}
+
+template <class T, class Allocator>
+double Array<T, Allocator>::totalArea(unsigned threads) const {
+    using namespace areaDetail;
+
+    size_t blocks = (data.size() + blockSize - 1) / blockSize;
+    std::vector<double> blockSums(blocks);
+    parallelFor(data.size(), blockSize, [&](size_t begin, size_t end) {
+        double areas[blockSize];
+        if constexpr (requires { typename FigureNumber<T>::type; }) {
+            blockAreas<typename FigureNumber<T>::type>(data.data() + begin, end - begin, areas);
+        } else {
+            for (size_t i = begin; i < end; ++i) areas[i - begin] = static_cast<double>(*data[i]);
+        }
+        blockSums[begin / blockSize] = pairwiseSum(areas, end - begin);
+    }, threads);
+
+    return pairwiseSum(blockSums.data(), blocks);
+}
+
+template <class T, class Allocator>
+void Array<T, Allocator>::printAll() const {
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::cout << "Figure " << i + 1 << ":\n";
+        data[i]->printVertices(std::cout);
+        std::cout << "\n";
+        auto center = data[i]->geometricCenter();
+        std::cout << "  Geometric center: (" << center.x << ", " << center.y << ")\n";
+        std::cout << "  Area: " << data[i]->area() << "\n";
+        std::cout << "  Is regular: " << (data[i]->isRegular() ? "Yes" : "No") << "\n\n";
+    }
+}
+
+template <class T, class Allocator>
+size_t Array<T, Allocator>::size() const {
+    return data.size();
+}
+
+template <class T, class Allocator>
+std::shared_ptr<T>& Array<T, Allocator>::get(size_t index) {
+    if (index < data.size()) {
+        return data[index];
+    }
+    throw std::out_of_range("Index out of range");
+}
+
+
+template <class T, class Allocator>
+template <class U, class... Args>
+    requires std::derived_from<U, T>
+U& Array<T, Allocator>::emplace(Args&&... args) {
+    using FigureAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+    auto elem = std::allocate_shared<U>(FigureAllocator(allocator), std::forward<Args>(args)...);
+    U& result = *elem;
+    data.push_back(std::move(elem));
+    return result;
+}
+
+template <class T, class Allocator>
+void Array<T, Allocator>::reserve(size_t count) {
+    data.reserve(count);
+}
+
+template <class T, class Allocator>
+size_t Array<T, Allocator>::capacity() const {
+    return data.capacity();
+}
+
+extern template class Array<Figure<double>>;
+extern template class Array<Figure<float>>;
+extern template class Array<Figure<std::int32_t>>;
+extern template class Array<Figure<std::int64_t>>;
+
 template<Number T>
 std::ostream& operator<<(std::ostream& os, const Figure<T>& figure);
 
@@ -0,0 +1,221 @@
+#ifndef PACKED_ARRAY_H
+#define PACKED_ARRAY_H
+
+#include "figures.h"
+#include <array>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+// Массив разнотипных фигур без отдельного узла в куче на каждую фигуру.
+// Фигуры типов Types... хранятся по значению, каждый тип - в своем непрерывном
+// векторе, и обходятся без виртуальных вызовов. Порядок добавления хранится
+// отдельно, поэтому индексы в add/remove/get/size те же, что у Array. Фигуры
+// других типов остаются указателями в отдельной группе.
+//
+// Отличия от Array:
+// - add(shared_ptr) копирует фигуру типа из Types, переданный указатель
+//   с хранимой фигурой больше не связан; фигуры других типов хранятся по
+//   этому указателю, как в Array;
+// - get() возвращает ссылку на саму фигуру, а не на shared_ptr. Ссылки и
+//   span из group() становятся недействительными после add и remove
+//   (вектор группы может переехать или сдвинуться);
+// - remove - O(n), как и у Array: сдвигаются вектор группы и порядок.
+template <class T, class... Types>
+class PackedArray {
+    static_assert((std::is_base_of_v<T, Types> && ...), "Types must derive from T");
+
+public:
+    // Копирует фигуру в группу ее типа; фигуры других типов хранятся указателем
+    void add(std::shared_ptr<T> elem);
+
+    template <class U>
+        requires (std::is_same_v<std::remove_cvref_t<U>, Types> || ...)
+    void add(U&& figure);
+
+    void remove(size_t index);
+    double totalArea() const;
+    void printAll() const;
+    size_t size() const;
+    T& get(size_t index);
+    const T& get(size_t index) const;
+
+    // Фигуры одного типа подряд в памяти, в порядке добавления
+    template <class U>
+    std::span<const U> group() const;
+
+    // f(std::span<const U>) для каждого типа из Types
+    template <class F>
+    void forEachGroup(F&& f) const;
+
+    // Фигуры, тип которых не входит в Types
+    std::span<const std::shared_ptr<T>> ungrouped() const { return others; }
+
+private:
+    static constexpr size_t othersGroup = sizeof...(Types);
+
+    struct Entry {
+        size_t group;
+        size_t position;
+    };
+
+    std::tuple<std::vector<Types>...> groups;
+    std::vector<std::shared_ptr<T>> others;
+    std::vector<Entry> order;
+
+    template <class U>
+    static constexpr size_t groupIndex() {
+        constexpr std::array<bool, sizeof...(Types)> same = {std::is_same_v<U, Types>...};
+        size_t i = 0;
+        while (same[i] == false) ++i;
+        return i;
+    }
+
+    template <size_t... I>
+    const T& at(const Entry& entry, std::index_sequence<I...>) const;
+
+    template <size_t... I>
+    void erase(const Entry& entry, std::index_sequence<I...>);
+
+    template <size_t... I>
+    bool addCopy(const T& figure, std::index_sequence<I...>);
+};
+
+template <class T, class... Types>
+template <size_t... I>
+const T& PackedArray<T, Types...>::at(const Entry& entry, std::index_sequence<I...>) const {
+    const T* result = nullptr;
+    ((entry.group == I && (result = &std::get<I>(groups)[entry.position])) || ...);
+    return result ? *result : *others[entry.position];
+}
+
+template <class T, class... Types>
+template <size_t... I>
+void PackedArray<T, Types...>::erase(const Entry& entry, std::index_sequence<I...>) {
+    auto eraseFrom = [&entry](auto& group) { group.erase(group.begin() + entry.position); };
+    bool erased = ((entry.group == I && (eraseFrom(std::get<I>(groups)), true)) || ...);
+    if (!erased) eraseFrom(others);
+}
+
+template <class T, class... Types>
+template <size_t... I>
+bool PackedArray<T, Types...>::addCopy(const T& figure, std::index_sequence<I...>) {
+    // Точное совпадение типа: наследник Types срезался бы при копировании
+    auto tryGroup = [this, &figure](auto& group, size_t index) {
+        using U = typename std::remove_reference_t<decltype(group)>::value_type;
+        if (typeid(figure) != typeid(U)) return false;
+        order.push_back({index, group.size()});
+        group.push_back(static_cast<const U&>(figure));
+        return true;
+    };
+    return (tryGroup(std::get<I>(groups), I) || ...);
+}
+
+template <class T, class... Types>
+void PackedArray<T, Types...>::add(std::shared_ptr<T> elem) {
+    if (elem && addCopy(*elem, std::index_sequence_for<Types...>())) return;
+    order.push_back({othersGroup, others.size()});
+    others.push_back(std::move(elem));
+}
+
+template <class T, class... Types>
+template <class U>
+    requires (std::is_same_v<std::remove_cvref_t<U>, Types> || ...)
+void PackedArray<T, Types...>::add(U&& figure) {
+    using Value = std::remove_cvref_t<U>;
+    auto& group = std::get<groupIndex<Value>()>(groups);
+    order.push_back({groupIndex<Value>(), group.size()});
+    group.push_back(std::forward<U>(figure));
+}
+
+template <class T, class... Types>
+void PackedArray<T, Types...>::remove(size_t index) {
+    if (index >= order.size()) return;
+
+    Entry removed = order[index];
+    erase(removed, std::index_sequence_for<Types...>());
+
+    // Внутри группы позиции растут вместе с индексом в order, поэтому
+    // сдвигаются только записи после удаленной - за тот же проход, что и сам сдвиг
+    for (size_t i = index + 1; i < order.size(); ++i) {
+        Entry entry = order[i];
+        if (entry.group == removed.group) --entry.position;
+        order[i - 1] = entry;
+    }
+    order.pop_back();
+}
+
+template <class T, class... Types>
+double PackedArray<T, Types...>::totalArea() const {
+    double total = 0;
+    // Тип элемента известен, поэтому area() вызывается без виртуальной диспетчеризации
+    forEachGroup([&total](auto figures) {
+        using U = typename decltype(figures)::value_type;
+        if constexpr (StaticFigureType<U>) {
+            total += sum_area(figures);
+        } else {
+            for (const U& figure : figures) {
+                total += figure.U::area();
+            }
+        }
+    });
+    for (const auto& elem : others) {
+        total += static_cast<double>(*elem);
+    }
+    return total;
+}
+
+template <class T, class... Types>
+void PackedArray<T, Types...>::printAll() const {
+    for (size_t i = 0; i < order.size(); ++i) {
+        const T& figure = get(i);
+        std::cout << "Figure " << i + 1 << ":\n";
+        figure.printVertices(std::cout);
+        std::cout << "\n";
+        auto center = figure.geometricCenter();
+        std::cout << "  Geometric center: (" << center.x << ", " << center.y << ")\n";
+        std::cout << "  Area: " << figure.area() << "\n";
+        std::cout << "  Is regular: " << (figure.isRegular() ? "Yes" : "No") << "\n\n";
+    }
+}
+
+template <class T, class... Types>
+size_t PackedArray<T, Types...>::size() const {
+    return order.size();
+}
+
+template <class T, class... Types>
+const T& PackedArray<T, Types...>::get(size_t index) const {
+    if (index < order.size()) {
+        return at(order[index], std::index_sequence_for<Types...>());
+    }
+    throw std::out_of_range("Index out of range");
+}
+
+template <class T, class... Types>
+T& PackedArray<T, Types...>::get(size_t index) {
+    return const_cast<T&>(std::as_const(*this).get(index));
+}
+
+template <class T, class... Types>
+template <class U>
+std::span<const U> PackedArray<T, Types...>::group() const {
+    return std::get<groupIndex<U>()>(groups);
+}
+
+template <class T, class... Types>
+template <class F>
+void PackedArray<T, Types...>::forEachGroup(F&& f) const {
+    std::apply([&f](const auto&... group) {
+        (f(std::span(group)), ...);
+    }, groups);
+}
+
+// Массив для фигур lab_04
+template <Number T>
+using FigureArray = PackedArray<Figure<T>, Triangle<T>, Hexagon<T>, Octagon<T>>;
+
+#endif
@@ -0,0 +1,135 @@
+#include "../include/bench.h"
+#include "../include/figures.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+size_t parseCount(const char* value, const char* name) {
+    try {
+        size_t pos = 0;
+        unsigned long long result = std::stoull(value, &pos);
+        if (pos != std::strlen(value) || value[0] == '-') throw std::invalid_argument(name);
+        return static_cast<size_t>(result);
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument(std::string("Invalid value for ") + name + ": " + value);
+    }
+}
+
+void printPhase(std::ostream& os, const char* type, const char* phase, Clock::duration elapsed, size_t items) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    os << std::left << std::setw(10) << type << std::setw(12) << phase << std::right
+       << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0
+       << std::setw(16) << std::setprecision(0) << (seconds > 0 ? items / seconds : 0.0) << "\n";
+}
+
+// Случайное значение в [from, to): у целых типов - целое
+template <Number T>
+T randomValue(std::mt19937& rng, T from, T to) {
+    if constexpr (std::integral<T>) {
+        return std::uniform_int_distribution<T>(from, to - 1)(rng);
+    } else {
+        return std::uniform_real_distribution<T>(from, to)(rng);
+    }
+}
+
+template <Number T>
+void benchType(std::ostream& os, const char* type, const BenchConfig& config) {
+    std::mt19937 rng(config.seed);
+    Array<Figure<T>> figures;
+    size_t total = config.figuresPerType * 3;
+
+    auto start = Clock::now();
+    figures.reserve(total);
+    for (size_t i = 0; i < config.figuresPerType; ++i) {
+        Point<T> origin(randomValue<T>(rng, 0, 1000), randomValue<T>(rng, 0, 1000));
+        figures.template emplace<Triangle<T>>(std::array<Point<T>, 3>{
+            origin,
+            origin + Point<T>(randomValue<T>(rng, 1, 10), 0),
+            origin + Point<T>(randomValue<T>(rng, 0, 10), randomValue<T>(rng, 1, 10))});
+    }
+    for (size_t i = 0; i < config.figuresPerType; ++i) {
+        Point<T> center(randomValue<T>(rng, 0, 1000), randomValue<T>(rng, 0, 1000));
+        figures.template emplace<Hexagon<T>>(center, randomValue<T>(rng, 1, 10));
+    }
+    for (size_t i = 0; i < config.figuresPerType; ++i) {
+        Point<T> center(randomValue<T>(rng, 0, 1000), randomValue<T>(rng, 0, 1000));
+        figures.template emplace<Octagon<T>>(center, randomValue<T>(rng, 1, 10));
+    }
+    printPhase(os, type, "generate", Clock::now() - start, total);
+
+    start = Clock::now();
+    double area = figures.totalArea();
+    printPhase(os, type, "area", Clock::now() - start, total);
+
+    // Один поток и все ядра: разница - выигрыш от параллельного расчета
+    start = Clock::now();
+    double blockArea = figures.totalArea(1);
+    printPhase(os, type, "blockArea1", Clock::now() - start, total);
+
+    start = Clock::now();
+    blockArea = figures.totalArea(0);
+    printPhase(os, type, "blockAreaN", Clock::now() - start, total);
+
+    start = Clock::now();
+    double centerSum = 0.0;
+    for (const auto& figure : figures) {
+        Point<double> center = figure->geometricCenter();
+        centerSum += center.x + center.y;
+    }
+    printPhase(os, type, "centers", Clock::now() - start, total);
+
+    // Результаты печатаются, чтобы замеряемые циклы не были выброшены оптимизатором
+    os << std::left << std::setw(10) << type << std::setprecision(6) << std::defaultfloat
+       << "total area: " << area << ", block area: " << blockArea
+       << ", mean center: " << (total > 0 ? centerSum / (2.0 * total) : 0.0) << "\n" << std::right;
+}
+
+}
+
+bool isBenchMode(int argc, char* argv[]) {
+    return argc > 1 && std::strcmp(argv[1], "--bench") == 0;
+}
+
+BenchConfig parseBenchArgs(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 2; i < argc; ++i) {
+        if (i + 1 >= argc) throw std::invalid_argument(std::string("Missing value for ") + argv[i]);
+
+        if (std::strcmp(argv[i], "--count") == 0) {
+            config.figuresPerType = parseCount(argv[++i], "--count");
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            config.seed = static_cast<unsigned>(parseCount(argv[++i], "--seed"));
+        } else {
+            throw std::invalid_argument(std::string("Unknown option: ") + argv[i]);
+        }
+    }
+    return config;
+}
+
+void runBench(const BenchConfig& config, std::ostream& os) {
+    os << "=== Benchmark ===\n";
+#ifndef __OPTIMIZE__
+    os << "Warning: built without optimizations, timings are not representative "
+          "(configure with -DCMAKE_BUILD_TYPE=Release)\n";
+#endif
+    os << "Figures per instantiation: " << config.figuresPerType * 3 << " (" << config.figuresPerType
+       << " per type), seed: " << config.seed
+       << ", threads (N): " << std::max(1u, std::thread::hardware_concurrency()) << "\n\n";
+    os << std::left << std::setw(10) << "type" << std::setw(12) << "phase" << std::right
+       << std::setw(12) << "time, ms" << std::setw(16) << "figures/s" << "\n";
+
+    benchType<double>(os, "double", config);
+    benchType<float>(os, "float", config);
+    benchType<std::int32_t>(os, "int32_t", config);
+    benchType<std::int64_t>(os, "int64_t", config);
+}
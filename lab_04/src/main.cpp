@@ -1,9 +1,21 @@
 #include "../include/figures.h"
+#include "../include/bench.h"
 #include <iostream>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (isBenchMode(argc, argv)) {
+        try {
+            runBench(parseBenchArgs(argc, argv), cout);
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+            cerr << "Usage: " << argv[0] << " --bench [--count N] [--seed S]" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     Array<Figure<double>> figures;
     int choice;
     
@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
 #include "../include/figures.h"
+#include "../include/packedArray.h"
+#include "../include/bench.h"
 #include <sstream>
 #include <cmath>
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <array>
+#include <random>
+#include <iterator>
+#include <numbers>
+#include <ranges>
+#include <cstdint>
 
 using namespace std;
 
@@ -64,6 +72,79 @@ TEST(FigureTest, OctagonAreaAndCenter) {
     EXPECT_NEAR(center.y, 2.0, 1e-6);
 }
 
+// --- Вершины правильных многоугольников ---
+
+template<int N>
+void expectUnitCircleMatchesLibm() {
+    for (int i = 0; i < N; ++i) {
+        double angle = 2 * std::numbers::pi * i / N;
+        EXPECT_NEAR(UnitCircle<N>::table[i].dx, std::cos(angle), 1e-15) << N << " " << i;
+        EXPECT_NEAR(UnitCircle<N>::table[i].dy, std::sin(angle), 1e-15) << N << " " << i;
+    }
+}
+
+TEST(VertexTableTest, UnitCircleMatchesLibm) {
+    expectUnitCircleMatchesLibm<3>();
+    expectUnitCircleMatchesLibm<5>();
+    expectUnitCircleMatchesLibm<6>();
+    expectUnitCircleMatchesLibm<8>();
+    expectUnitCircleMatchesLibm<64>();
+
+    // Таблица - константа времени компиляции, точки на осях точные
+    static_assert(UnitCircle<8>::table[2].dx == 0.0 && UnitCircle<8>::table[2].dy == 1.0);
+    static_assert(UnitCircle<6>::table[3].dx == -1.0);
+    EXPECT_EQ(UnitCircle<6>::table[3].dy, 0.0);
+}
+
+TEST(VertexTableTest, LazyVertexIteration) {
+    OctagonD oct(Point<double>(1.0, 2.0), 2.0);
+    auto vertices = oct.vertices();
+    static_assert(std::forward_iterator<decltype(vertices.begin())>);
+    EXPECT_EQ(std::distance(vertices.begin(), vertices.end()), 8);
+
+    int i = 0;
+    for (const Point<double>& v : oct.vertices()) {
+        double angle = 2 * std::numbers::pi * i / 8;
+        EXPECT_NEAR(v.x, 1.0 + 2.0 * std::cos(angle), 1e-12);
+        EXPECT_NEAR(v.y, 2.0 + 2.0 * std::sin(angle), 1e-12);
+        EXPECT_EQ(v, vertices[i]);
+        ++i;
+    }
+    EXPECT_EQ(vertices[0], Point<double>(3.0, 2.0));
+    EXPECT_THROW(vertices[8], std::out_of_range);
+
+    auto hex = createTestHexagon();
+    EXPECT_EQ(std::ranges::distance(hex->vertices()), 6);
+    EXPECT_EQ(hex->vertices()[3], Point<double>(-1.0, 0.0));
+}
+
+TEST(RegularPolygonTest, ArbitraryVertexCount) {
+    static_assert(std::is_same_v<HexagonD, RegularPolygon<double, 6>>);
+    static_assert(RegularPolygon<double, 4>::areaCoefficient == 2.0);
+
+    RegularPolygon<double, 5> pentagon(Point<double>(0.0, 0.0), 2.0);
+    double side = 2 * 2.0 * std::sin(std::numbers::pi / 5);
+    EXPECT_NEAR(pentagon.area(), 0.25 * std::sqrt(5 * (5 + 2 * std::sqrt(5.0))) * side * side, 1e-12);
+    EXPECT_TRUE(pentagon.isRegular());
+
+    // При большом N площадь стремится к площади круга
+    RegularPolygon<double, 64> polygon64(Point<double>(1.0, 1.0), 1.0);
+    EXPECT_NEAR(polygon64.area(), std::numbers::pi, 0.01);
+    EXPECT_EQ(std::ranges::distance(polygon64.vertices()), 64);
+
+    ostringstream oss;
+    oss << static_cast<const FigureD&>(pentagon) << "\n" << static_cast<const FigureD&>(polygon64);
+    EXPECT_NE(oss.str().find("Pentagon vertices"), string::npos);
+    EXPECT_NE(oss.str().find("Regular 64-gon vertices"), string::npos);
+
+    // Разное число вершин - разные типы
+    RegularPolygon<double, 5> same(Point<double>(0.0, 0.0), 2.0);
+    HexagonD hex(Point<double>(0.0, 0.0), 2.0);
+    EXPECT_TRUE(pentagon == static_cast<const FigureD&>(same));
+    EXPECT_FALSE(pentagon == static_cast<const FigureD&>(hex));
+    EXPECT_TRUE(*pentagon.clone() == pentagon);
+}
+
 // --- Ввод/вывод ---
 
 TEST(FigureTest, TriangleInputOutput) {
@@ -107,6 +188,31 @@ TEST(CopyMoveTest, TriangleCopyAndMove) {
     EXPECT_NEAR(static_cast<double>(tri5), original_area, 1e-6);
 }
 
+TEST(CopyMoveTest, TriangleVerticesStoredInline) {
+    static_assert(std::is_trivially_copyable_v<Point<double>>);
+
+    auto tri = createTestTriangle();
+    auto vertices = tri->getVertices();
+    ASSERT_EQ(vertices.size(), 3u);
+    EXPECT_EQ(vertices[1], Point<double>(3.0, 0.0));
+    EXPECT_EQ(vertices[2], Point<double>(0.0, 4.0));
+
+    // Копия не разделяет вершины с оригиналом
+    TriangleD copy(*tri);
+    istringstream iss("1 1 2 1 1 2");
+    iss >> static_cast<FigureD&>(copy);
+    EXPECT_EQ(copy.getVertices()[0], Point<double>(1.0, 1.0));
+    EXPECT_EQ(vertices[0], Point<double>(0.0, 0.0));
+    EXPECT_NEAR(copy.area(), 0.5, 1e-12);
+
+    // Представление смотрит на текущие вершины объекта
+    *tri = copy;
+    EXPECT_EQ(vertices[2], Point<double>(1.0, 2.0));
+
+    auto clone = tri->clone();
+    EXPECT_TRUE(*clone == *tri);
+}
+
 // --- Сравнение фигур ---
 
 TEST(ComparisonTest, TriangleEqualityAndInequality) {
@@ -142,6 +248,7 @@ TEST(ComparisonTest, DifferentTypesNotEqual) {
     EXPECT_FALSE(tri.operator==(f_hex));
     EXPECT_FALSE(tri.operator==(f_oct));
     EXPECT_FALSE(hex.operator==(f_oct));
+    EXPECT_FALSE(oct.operator==(f_tri));
 }
 
 // --- Полиморфизм и clone ---
@@ -196,6 +303,113 @@ TEST(ArrayTest, AddRemoveAndTotalArea) {
     EXPECT_NEAR(arr.totalArea(), area_hex, 1e-6);
 }
 
+// Считает выделения памяти, чтобы проверить, что Array пользуется аллокатором
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    size_t* allocations;
+
+    explicit CountingAllocator(size_t* allocations) : allocations(allocations) {}
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& other) : allocations(other.allocations) {}
+
+    T* allocate(size_t n) {
+        ++*allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <class U>
+    bool operator==(const CountingAllocator<U>& other) const { return allocations == other.allocations; }
+};
+
+TEST(ArrayTest, ReserveEmplaceAndIterators) {
+    Array<FigureD> arr;
+    arr.reserve(16);
+    EXPECT_GE(arr.capacity(), 16u);
+    size_t capacity = arr.capacity();
+
+    TriangleD& tri = arr.emplace<TriangleD>(array<Point<double>, 3>{Point<double>(0, 0), Point<double>(3, 0), Point<double>(0, 4)});
+    arr.emplace<HexagonD>(Point<double>(0.0, 0.0), 1.0);
+    arr.emplace<OctagonD>(Point<double>(0.0, 0.0), 0.5);
+    arr.add(createTestTriangle());
+    EXPECT_EQ(arr.size(), 4u);
+    EXPECT_EQ(arr.capacity(), capacity);
+    EXPECT_EQ(&tri, arr.get(0).get());
+
+    // Итераторы произвольного доступа работают со стандартными алгоритмами
+    static_assert(std::random_access_iterator<Array<FigureD>::iterator>);
+    EXPECT_EQ(arr.end() - arr.begin(), 4);
+    std::sort(arr.begin(), arr.end(), [](const auto& a, const auto& b) { return a->area() < b->area(); });
+    EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end(), [](const auto& a, const auto& b) { return a->area() < b->area(); }));
+    EXPECT_NEAR(arr.begin()[0]->area(), OctagonD(Point<double>(0.0, 0.0), 0.5).area(), 1e-12);
+
+    const Array<FigureD>& view = arr;
+    double total = 0.0;
+    for (const auto& fig : view) total += fig->area();
+    EXPECT_NEAR(total, arr.totalArea(), 1e-12);
+}
+
+TEST(ArrayTest, CustomAllocator) {
+    size_t allocations = 0;
+    CountingAllocator<FigureD> alloc(&allocations);
+    Array<FigureD, CountingAllocator<FigureD>> arr(alloc);
+
+    arr.reserve(4);
+    EXPECT_EQ(allocations, 1u);
+    arr.emplace<HexagonD>(Point<double>(1.0, 1.0), 2.0);
+    arr.emplace<TriangleD>();
+    // По одному выделению на фигуру вместе со счетчиком ссылок
+    EXPECT_EQ(allocations, 3u);
+    EXPECT_EQ(arr.size(), 2u);
+    EXPECT_TRUE(arr.get_allocator() == alloc);
+
+    arr.remove(0);
+    EXPECT_NEAR(arr.totalArea(), 0.0, 1e-12);
+}
+
+TEST(ArrayTest, ParallelTotalAreaIsDeterministic) {
+    Array<FigureD> arr;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(-100.0, 100.0);
+    std::uniform_real_distribution<double> radius(0.1, 10.0);
+    long double reference = 0.0L;
+    for (int i = 0; i < 20000; ++i) {
+        Point<double> p(coord(rng), coord(rng));
+        switch (i % 4) {
+            case 0:
+                arr.emplace<TriangleD>(array<Point<double>, 3>{p, Point<double>(coord(rng), coord(rng)),
+                                                              Point<double>(coord(rng), coord(rng))});
+                break;
+            case 1:
+                arr.emplace<HexagonD>(p, radius(rng));
+                break;
+            case 2:
+                arr.emplace<OctagonD>(p, radius(rng));
+                break;
+            default:
+                arr.emplace<RegularPolygon<double, 5>>(p, radius(rng));
+        }
+        reference += arr.get(arr.size() - 1)->area();
+    }
+
+    double single = arr.totalArea(1);
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+        EXPECT_EQ(arr.totalArea(threads), single);
+    }
+    EXPECT_NEAR(single, static_cast<double>(reference), 1e-12 * single);
+    EXPECT_NEAR(arr.totalArea(), single, 1e-9 * single);
+
+    // Площадь каждого типа совпадает с area() до бита
+    for (size_t i = 0; i < 4; ++i) {
+        Array<FigureD> one;
+        one.add(arr.get(i));
+        EXPECT_EQ(one.totalArea(2), arr.get(i)->area()) << i;
+    }
+    EXPECT_EQ(Array<FigureD>().totalArea(4), 0.0);
+}
+
 TEST(ArrayTest, PrintAllFiguresInfo) {
     Array<FigureD> arr;
     arr.add(createTestTriangle());
@@ -217,6 +431,230 @@ TEST(ArrayTest, PrintAllFiguresInfo) {
     EXPECT_NE(out.find("Area"), std::string::npos);
 }
 
+TEST(PackedArrayTest, SameSemanticsAsArray) {
+    FigureArray<double> packed;
+    Array<FigureD> plain;
+
+    vector<shared_ptr<FigureD>> figures = {
+        createTestTriangle(),
+        createTestHexagon(),
+        createTestOctagon(),
+        make_shared<RegularPolygon<double, 5>>(Point<double>(0.0, 0.0), 1.0),
+        createTestTriangle(),
+    };
+    for (const auto& fig : figures) {
+        packed.add(fig);
+        plain.add(fig);
+    }
+    packed.add(TriangleD(array<Point<double>, 3>{Point<double>(0, 0), Point<double>(1, 0), Point<double>(0, 1)}));
+    plain.add(make_shared<TriangleD>(array<Point<double>, 3>{Point<double>(0, 0), Point<double>(1, 0), Point<double>(0, 1)}));
+
+    ASSERT_EQ(packed.size(), 6u);
+    EXPECT_NEAR(packed.totalArea(), plain.totalArea(), 1e-12);
+
+    // Фигуры одного типа лежат подряд, остальные - в отдельной группе
+    auto triangles = packed.group<TriangleD>();
+    ASSERT_EQ(triangles.size(), 3u);
+    EXPECT_EQ(&triangles[1], &triangles[0] + 1);
+    EXPECT_EQ(packed.ungrouped().size(), 1u);
+    size_t grouped = 0;
+    packed.forEachGroup([&grouped](auto group) { grouped += group.size(); });
+    EXPECT_EQ(grouped, 5u);
+
+    // Хранятся копии, а не общие объекты
+    EXPECT_NE(&packed.get(0), figures[0].get());
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(packed.get(i) == *figures[i]) << i;
+    }
+
+    packed.remove(1);
+    packed.remove(0);
+    plain.remove(1);
+    plain.remove(0);
+    packed.remove(100);
+    ASSERT_EQ(packed.size(), 4u);
+    for (size_t i = 0; i < packed.size(); ++i) {
+        EXPECT_TRUE(packed.get(i) == *plain.get(i)) << i;
+    }
+    EXPECT_EQ(packed.group<TriangleD>().size(), 2u);
+    EXPECT_TRUE(packed.group<HexagonD>().empty());
+    EXPECT_NEAR(packed.totalArea(), plain.totalArea(), 1e-12);
+    EXPECT_THROW(packed.get(4), std::out_of_range);
+}
+
+TEST(PackedArrayTest, RandomRemovalsKeepOrder) {
+    FigureArray<double> packed;
+    Array<FigureD> plain;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 200; ++i) {
+        shared_ptr<FigureD> fig;
+        switch (i % 4) {
+            case 0: fig = make_shared<TriangleD>(array<Point<double>, 3>{Point<double>(i, 0), Point<double>(0, 1), Point<double>(1, 1)}); break;
+            case 1: fig = make_shared<HexagonD>(Point<double>(i, 0), 1.0); break;
+            case 2: fig = make_shared<OctagonD>(Point<double>(i, 0), 1.0); break;
+            default: fig = make_shared<RegularPolygon<double, 5>>(Point<double>(i, 0), 1.0);
+        }
+        packed.add(fig);
+        plain.add(fig);
+    }
+
+    // Хранимая копия не связана с исходным указателем, а pentagon - связан
+    EXPECT_NE(&packed.get(0), plain.get(0).get());
+    EXPECT_EQ(&packed.get(3), plain.get(3).get());
+
+    while (packed.size() > 0) {
+        size_t index = std::uniform_int_distribution<size_t>(0, packed.size() - 1)(rng);
+        packed.remove(index);
+        plain.remove(index);
+        ASSERT_EQ(packed.size(), plain.size());
+        for (size_t i = 0; i < packed.size(); ++i) {
+            ASSERT_TRUE(packed.get(i) == *plain.get(i)) << i;
+        }
+    }
+}
+
+// --- Статический интерфейс StaticFigure ---
+
+// Пустая база не увеличивает размер фигур
+static_assert(sizeof(TriangleD) == sizeof(void*) + 6 * sizeof(double));
+static_assert(sizeof(HexagonD) == sizeof(void*) + 3 * sizeof(double));
+static_assert(StaticFigureType<TriangleD> && StaticFigureType<RegularPolygon<float, 5>>);
+static_assert(!StaticFigureType<FigureD>);
+
+template <class F>
+double staticArea(const StaticFigure<F, typename F::Coordinate>& figure) {
+    return figure.area();
+}
+
+TEST(StaticFigureTest, SameResultsAsVirtualInterface) {
+    auto tri = createTestTriangle();
+    auto oct = createTestOctagon();
+    EXPECT_EQ(staticArea(*tri), static_cast<const FigureD&>(*tri).area());
+    EXPECT_EQ(staticArea(*oct), static_cast<const FigureD&>(*oct).area());
+
+    const StaticFigure<OctagonD, double>& staticOct = *oct;
+    EXPECT_TRUE(staticOct.isRegular());
+    EXPECT_EQ(staticOct.geometricCenter(), oct->geometricCenter());
+    shared_ptr<OctagonD> copy = staticOct.clone();
+    EXPECT_TRUE(*copy == *oct);
+    EXPECT_NE(copy.get(), oct.get());
+}
+
+TEST(StaticFigureTest, BatchAlgorithms) {
+    FigureArray<double> packed;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coord(-50.0, 50.0);
+    for (int i = 0; i < 100; ++i) {
+        packed.add(TriangleD({Point<double>(coord(rng), coord(rng)), Point<double>(coord(rng), coord(rng)),
+                              Point<double>(coord(rng), coord(rng))}));
+        packed.add(HexagonD(Point<double>(coord(rng), coord(rng)), std::abs(coord(rng))));
+    }
+
+    auto triangles = packed.group<TriangleD>();
+    double expected = 0;
+    for (const TriangleD& tri : triangles) expected += static_cast<const FigureD&>(tri).area();
+    EXPECT_EQ(sum_area(triangles), expected);
+    EXPECT_EQ(sum_area(std::vector<OctagonD>()), 0.0);
+
+    vector<Point<double>> result;
+    centers(packed.group<HexagonD>(), back_inserter(result));
+    ASSERT_EQ(result.size(), 100u);
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i], packed.group<HexagonD>()[i].geometricCenter()) << i;
+    }
+
+    // Работает и для целых координат
+    vector<Triangle<std::int64_t>> exact(3, Triangle<std::int64_t>({Point<std::int64_t>(0, 0),
+                                                                  Point<std::int64_t>(1, 0),
+                                                                  Point<std::int64_t>(0, 1)}));
+    EXPECT_EQ(sum_area(exact), 1.5);
+}
+
+// --- Инстанциации float, int32_t, int64_t ---
+
+template <class T>
+class NumberTypeTest : public testing::Test {};
+
+using NumberTypes = testing::Types<float, std::int32_t, std::int64_t>;
+TYPED_TEST_SUITE(NumberTypeTest, NumberTypes);
+
+TYPED_TEST(NumberTypeTest, FiguresAndArray) {
+    using T = TypeParam;
+    Triangle<T> tri({Point<T>(0, 0), Point<T>(3, 0), Point<T>(0, 4)});
+    EXPECT_EQ(tri.area(), 6.0);
+    EXPECT_NEAR(tri.geometricCenter().x, 1.0, 1e-6);
+    EXPECT_NEAR(tri.geometricCenter().y, 4.0 / 3.0, 1e-6);
+
+    Hexagon<T> hex(Point<T>(1, 2), 2);
+    EXPECT_NEAR(hex.area(), 6.0 * std::sqrt(3.0), 1e-9);
+    EXPECT_EQ(hex.geometricCenter().x, 1.0);
+
+    Array<Figure<T>> arr;
+    arr.add(tri.clone());
+    arr.template emplace<Hexagon<T>>(Point<T>(1, 2), 2);
+    arr.template emplace<Octagon<T>>(Point<T>(0, 0), 1);
+    EXPECT_NEAR(arr.totalArea(), 6.0 + 6.0 * std::sqrt(3.0) + 2.0 * std::sqrt(2.0), 1e-9);
+    EXPECT_EQ(arr.totalArea(2), arr.totalArea(1));
+
+    std::istringstream in("1 1 5 1 1 4");
+    Triangle<T> read;
+    in >> read;
+    EXPECT_TRUE(read == Triangle<T>({Point<T>(1, 1), Point<T>(5, 1), Point<T>(1, 4)}));
+    std::ostringstream out;
+    out << read;
+    EXPECT_EQ(out.str(), "Triangle vertices: (1, 1) (5, 1) (1, 4) ");
+}
+
+TEST(NumberTypeTest, IntegerTriangleAreaIsExact) {
+    // Через double x = 2^53 + 1 округлилось бы до 2^53, и площадь стала бы нулевой
+    const std::int64_t big = std::int64_t(1) << 53;
+    Triangle<std::int64_t> small({Point<std::int64_t>(big, big), Point<std::int64_t>(big + 1, big),
+                                  Point<std::int64_t>(big, big + 1)});
+    EXPECT_TRUE(small.doubledArea() == 1);
+    EXPECT_EQ(small.area(), 0.5);
+
+    // Произведения координат не помещаются в 64 бита
+    const std::int64_t huge = std::int64_t(1) << 61;
+    Triangle<std::int64_t> large({Point<std::int64_t>(0, 0), Point<std::int64_t>(huge, 1),
+                                  Point<std::int64_t>(1, huge)});
+    EXPECT_TRUE(large.doubledArea() == (WideInt(1) << 122) - 1);
+    Triangle<std::int64_t> reversed({Point<std::int64_t>(0, 0), Point<std::int64_t>(1, huge),
+                                     Point<std::int64_t>(huge, 1)});
+    EXPECT_TRUE(reversed.doubledArea() == -large.doubledArea());
+    EXPECT_EQ(reversed.area(), large.area());
+
+    // int32_t: разность координат выходит за 32 бита
+    Triangle<std::int32_t> wide({Point<std::int32_t>(INT32_MIN, INT32_MIN), Point<std::int32_t>(INT32_MAX, INT32_MIN),
+                                 Point<std::int32_t>(INT32_MIN, INT32_MAX)});
+    EXPECT_TRUE(wide.doubledArea() == WideInt(UINT32_MAX) * UINT32_MAX);
+
+    // Блочная сумма берет ту же точную площадь
+    Array<Figure<std::int64_t>> arr;
+    arr.add(small.clone());
+    EXPECT_EQ(arr.totalArea(2), 0.5);
+}
+
+TEST(BenchTest, ParseArgumentsAndRun) {
+    char prog[] = "lab_04_run", bench[] = "--bench", count[] = "--count", n[] = "50",
+         seed[] = "--seed", s[] = "7";
+    char* argv[] = {prog, bench, count, n, seed, s};
+    ASSERT_TRUE(isBenchMode(6, argv));
+    EXPECT_FALSE(isBenchMode(1, argv));
+    BenchConfig config = parseBenchArgs(6, argv);
+    EXPECT_EQ(config.figuresPerType, 50u);
+    EXPECT_EQ(config.seed, 7u);
+    char* missing[] = {prog, bench, count};
+    EXPECT_THROW(parseBenchArgs(3, missing), std::invalid_argument);
+
+    std::ostringstream out;
+    runBench(config, out);
+    std::string report = out.str();
+    for (const char* type : {"double", "float", "int32_t", "int64_t"}) {
+        EXPECT_NE(report.find(std::string(type) + " "), std::string::npos) << type;
+    }
+    EXPECT_NE(report.find("blockArea"), std::string::npos);
+}
+
 // --- Крайние случаи ---
 
 TEST(EdgeCaseTest, DefaultConstructorsNonNegativeArea) {